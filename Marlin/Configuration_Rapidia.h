@@ -29,6 +29,36 @@
 // pause feature R751/752 is enabled (requires RAPIDIA_BLOCK_SOURCE)
 #define RAPIDIA_PAUSE
 
+// R751/R752 are carried out by the stepper ISR as soon as they're received: the block being
+// stepped is cut short (or carried on along its line) to decelerate from the current step,
+// rather than the planner replanning from the next block boundary it can reach on idle.
+// the pause report adds the time from receipt to rest.
+#define RAPIDIA_STEPPER_PAUSE
+
+// R754 resumes a pause without the host re-sending: an R752 keeps the rest of the gcode it
+// interrupted (the blocks the steppers didn't reach, up to the gcode's last), and R754 goes
+// back to where extrusion stopped and replans them. (requires RAPIDIA_STEPPER_PAUSE)
+// costs ~20 bytes of RAM per planner block.
+//#define RAPIDIA_PAUSE_RESUME
+
+// G2/G3 arcs use the longest chords which stay within this distance (mm) of the arc,
+// between MM_PER_ARC_SEGMENT and RAPIDIA_ARC_MAX_SEGMENT_MM long.
+// (rather than fixed MM_PER_ARC_SEGMENT chords, which flood the planner on dense arc toolpaths.)
+#define RAPIDIA_ARC_CHORD_TOLERANCE 0.01
+#define RAPIDIA_ARC_MAX_SEGMENT_MM 5
+
+// serial lines are read (straight out of the RX buffer, where the HAL allows) into this
+// many staging lines, which feed the command queue. this keeps the RX buffer draining
+// while the queue is full. costs MAX_CMD_SIZE + ~8 bytes of RAM per line.
+//#define RAPIDIA_RX_STAGING
+#define RAPIDIA_RX_STAGING_LINES 4
+
+// SD prints are read ahead (from idle) into two buffers of this many bytes, and scanned
+// for lines a buffer at a time, rather than read from the file a byte at a time.
+// (512 reads whole sectors straight into the buffers, where RAM allows.)
+//#define RAPIDIA_SD_READ_AHEAD
+#define RAPIDIA_SD_READ_AHEAD_SIZE 256
+
 // M736/M737 alias for M106/M107
 #define RAPIDIA_LAMP_ALIAS
 
@@ -77,6 +107,25 @@
 // allow computing checksums for heartbeat, etc.
 #define RAPIDIA_CHECKSUMS
 
+// R760 switches the serial port to compact binary move frames (requires RAPIDIA_CHECKSUMS)
+// costs twice the frame size + ~30 bytes of RAM.
+//#define RAPIDIA_BINARY_MOTION
+
+// largest binary move frame payload (bytes). two frames are buffered.
+#define RAPIDIA_BINARY_MOTION_FRAME_SIZE 64
+
+// R761 switches to batched acknowledgements: one "ack:{...}" line for several commands,
+// with the free queue slots and planner blocks. (requires RAPIDIA_LINE_AUTO_REPORTING)
+#define RAPIDIA_BATCHED_OK
+
+// acknowledge once this many commands are pending (R761 B),
+// or once the oldest has waited this long (ms, R761 T).
+#define RAPIDIA_BATCHED_OK_COUNT 2
+#define RAPIDIA_BATCHED_OK_MS 20
+
+// bytes of stack used to assemble heartbeat/pause report lines before writing them out.
+//#define RAPIDIA_SERIAL_LINE_SIZE 96
+
 // reports UUID in capabilities (M115)
 #define RAPIDIA_REPORT_UUID
 
@@ -87,15 +136,77 @@
 // must be enough room for the other eeprom settings to fit before this.
 #define RAPIDIA_MILEAGE_EEPROM_START 0x400
 
-// saving every 100 seconds, we can (only) support 150 days of EEPROM writing.
-// (EEPROM safe for ~100,000 writes.)
+// saves rotate through all RAPIDIA_MILEAGE_SAVE_MULTIPLICITY slots, so saving
+// every 20 seconds supports ~6 years of continuous extrusion.
+// (no save is made while nothing has been extruded.)
 // (measured in seconds)
-#define RAPIDIA_MILEAGE_SAVE_INTERVAL 100
+#define RAPIDIA_MILEAGE_SAVE_INTERVAL 20
 
+// number of record slots in the mileage journal.
 // this multiplies the lifetime of the mileage eeprom data,
 // at the cost of using this many times redundant eeprom.
 #define RAPIDIA_MILEAGE_SAVE_MULTIPLICITY 100
 
+// writes each EEPROM cell is rated for. (used to estimate the write budget, R747.)
+#define RAPIDIA_MILEAGE_EEPROM_ENDURANCE 100000
+
+// times the main loop's tasks and the gaps between serial reads (R748, heartbeat D).
+// costs a micros() read per task per idle() pass.
+//#define RAPIDIA_TASK_PROFILER
+
+// times the phases of the stepper ISR (R807).
+// costs a few µs per stepper ISR, so leave it off in production.
+//#define RAPIDIA_ISR_PROFILER
+
+// the planner's reverse pass stops at the first block whose entry speed a new block
+// leaves unchanged, and trapezoids are only recalculated from where the forward pass
+// starts, so replanning doesn't grow with BLOCK_BUFFER_SIZE. (R808 S)
+#define RAPIDIA_INCREMENTAL_REPLAN
+
+// planner trapezoids (accelerate/decelerate step counts) are calculated in 32-bit integer
+// arithmetic rather than float, which is much cheaper on AVR.
+// (checked against the float version by the LINUX simulator's --check-trapezoids.)
+#define RAPIDIA_FIXED_TRAPEZOID
+
+// bilinear bed leveling looks Z up from a table of each grid cell's surface, built when the
+// grid changes, in integer arithmetic. (moves split on grid lines are walked cell to cell,
+// rather than split recursively.) costs 8 bytes of RAM per grid cell.
+// (compared with the float lookup by the LINUX simulator's --bench-leveling.)
+#ifdef RAPIDIA_METAL
+  #define RAPIDIA_ABL_PLANE_TABLE
+#endif
+
+// SEGMENT_LEVELED_MOVES splits leveled moves where they cross the bilinear grid, and each
+// piece into as few segments as keep within this distance (mm) of the cell's surface, rather
+// than into LEVELED_SEGMENT_LENGTH pieces. (flat cells take one segment.) R809 reports the
+// segments per move. (requires RAPIDIA_ABL_PLANE_TABLE)
+#ifdef RAPIDIA_METAL
+  #define RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS
+  #define RAPIDIA_LEVELED_SEGMENT_TOLERANCE 0.005
+#endif
+
+// in full control mode (M605 S0), R762 moves the idle X carriage without waiting for the active
+// one: the stepper ISR steps it alongside the blocks buffered after it, kept
+// RAPIDIA_CARRIAGE_INTERVAL clear of the active carriage, and tool changes don't synchronize.
+// (so T1 can move into place during T0's last moves.) (requires DUAL_X_CARRIAGE, and RAPIDIA_STEPPER_PAUSE
+// with RAPIDIA_PAUSE)
+#define RAPIDIA_IDLE_CARRIAGE
+
+// in auto-park mode (M605 S1), a tool change queues the raise, the park, the carriage swap and
+// the unpark as planner blocks behind the moves before it, rather than waiting for the planner
+// to empty before the park and after the unpark. (requires RAPIDIA_IDLE_CARRIAGE, whose swap
+// blocks undo a tool change a pause or quick stop discards.)
+#define RAPIDIA_QUEUED_TOOL_CHANGE
+
+// the hotend PID runs in 32-bit integer arithmetic rather than float, with its gains converted
+// when they're set (M301, settings). (requires PIDTEMP)
+// (the LINUX simulator's --bench-heater times manage_heater(), and checks it against float.)
+#define RAPIDIA_FIXED_PID
+
+// counts the blocks each planner recalculation visits, and times it (R808).
+// costs a micros() read per planned block.
+//#define RAPIDIA_REPLAN_STATS
+
 // performs some stack monitoring
 #if ENABLED(RAPIDIA_DEV)
   #define RAPIDIA_STACK_UTIL
@@ -94,6 +94,7 @@ typedef int8_t pin_t;
   #endif
 
   #define MYSERIAL0 customizedSerial1
+  #define HAL_SERIAL_RX_SPAN      // MYSERIAL0/1 have rx_span()/rx_consume()
 
   #ifdef SERIAL_PORT_2
     #if !WITHIN(SERIAL_PORT_2, -1, 3)
@@ -394,6 +394,13 @@
     // if it interrupts the writing of the value of that variable in the middle.
     atomic_set_rx_tail(t);
 
+    check_xon(h, t);
+
+    return v;
+  }
+
+  template<typename Cfg>
+  FORCE_INLINE void MarlinSerial<Cfg>::check_xon(const ring_buffer_pos_t h, const ring_buffer_pos_t t) {
     if (Cfg::XONOFF) {
       // If the XOFF char was sent, or about to be sent...
       if ((xon_xoff_state & XON_XOFF_CHAR_MASK) == XOFF_CHAR) {
@@ -415,8 +422,23 @@
         }
       }
     }
+  }
 
-    return v;
+  template<typename Cfg>
+  typename MarlinSerial<Cfg>::ring_buffer_pos_t MarlinSerial<Cfg>::rx_span(const uint8_t* &span) {
+    const ring_buffer_pos_t h = atomic_read_rx_head(), t = rx_buffer.tail;
+    span = rx_buffer.buffer + t;
+    // Up to the head, or to the end of the buffer if the head has wrapped around
+    return h >= t ? h - t : Cfg::RX_SIZE - t;
+  }
+
+  template<typename Cfg>
+  void MarlinSerial<Cfg>::rx_consume(const ring_buffer_pos_t n) {
+    if (!n) return;
+    const ring_buffer_pos_t h = atomic_read_rx_head(),
+                            t = (ring_buffer_pos_t)(rx_buffer.tail + n) & (Cfg::RX_SIZE - 1);
+    atomic_set_rx_tail(t);
+    check_xon(h, t);
   }
 
   template<typename Cfg>
@@ -202,6 +202,9 @@
     static FORCE_INLINE void atomic_set_rx_tail(ring_buffer_pos_t value);
     static FORCE_INLINE ring_buffer_pos_t atomic_read_rx_tail();
 
+    // Ask for XON once the RX buffer has drained (after the tail moves to t)
+    static FORCE_INLINE void check_xon(const ring_buffer_pos_t h, const ring_buffer_pos_t t);
+
     public:
 
     FORCE_INLINE static void store_rxd_char();
@@ -219,6 +222,12 @@
       static int read();
       static void flush();
       static ring_buffer_pos_t available();
+
+      // Block reads: rx_span points span at the oldest received byte and returns how many
+      // follow it contiguously in the RX buffer; rx_consume releases the first n of them.
+      static ring_buffer_pos_t rx_span(const uint8_t* &span);
+      static void rx_consume(const ring_buffer_pos_t n);
+
       static void write(const uint8_t c);
       static void flushTX();
       #ifdef DGUS_SERIAL_PORT
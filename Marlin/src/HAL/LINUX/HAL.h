@@ -62,6 +62,7 @@ uint8_t _getc();
 
 extern HalSerial usb_serial;
 #define MYSERIAL0 usb_serial
+#define HAL_SERIAL_RX_SPAN      // MYSERIAL0 has rx_span()/rx_consume()
 #define NUM_SERIAL 1
 
 #define ST7920_DELAY_1 DELAY_NS(600)
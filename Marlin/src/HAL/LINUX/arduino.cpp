@@ -27,18 +27,25 @@
 #include "../shared/Delay.h"
 
 // Interrupts
-void cli() { } // Disable
-void sei() { } // Enable
+void cli() { VirtualTime::mask(true); } // Disable
+void sei() { VirtualTime::mask(false); } // Enable
 
 // Time functions
 void _delay_ms(const int delay_ms) {
   delay(delay_ms);
 }
 
+// In virtual time every read costs a little, so that loops polling the clock progress
 uint32_t millis() {
+  if (VirtualTime::enabled()) VirtualTime::consume();
   return (uint32_t)Clock::millis();
 }
 
+uint32_t micros() {
+  if (VirtualTime::enabled()) VirtualTime::consume();
+  return (uint32_t)Clock::micros();
+}
+
 // This is required for some Arduino libraries we are using
 void delayMicroseconds(uint32_t us) {
   Clock::delayMicros(us);
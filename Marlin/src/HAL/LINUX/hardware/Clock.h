@@ -24,6 +24,8 @@
 #include <chrono>
 #include <thread>
 
+#include "VirtualTime.h"
+
 class Clock {
 public:
   static uint64_t ticks(uint32_t frequency = Clock::frequency) {
@@ -45,6 +47,7 @@ public:
 
   // Time Acceleration compensated
   static uint64_t nanos() {
+    if (VirtualTime::enabled()) return VirtualTime::nanos();
     auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
     return (now.count() - Clock::startup.count()) * Clock::time_multiplier;
   }
@@ -61,19 +64,24 @@ public:
     return Clock::nanos() / 1000000000.0;
   }
 
+  // In virtual time, delays advance the clock instead of sleeping
   static void delayCycles(uint64_t cycles) {
+    if (VirtualTime::enabled()) return VirtualTime::advance((1000000000L / frequency) * cycles);
     std::this_thread::sleep_for(std::chrono::nanoseconds( (1000000000L / frequency) * cycles) / Clock::time_multiplier );
   }
 
   static void delayMicros(uint64_t micros) {
+    if (VirtualTime::enabled()) return VirtualTime::advance(micros * 1000);
     std::this_thread::sleep_for(std::chrono::microseconds( micros ) / Clock::time_multiplier);
   }
 
   static void delayMillis(uint64_t millis) {
+    if (VirtualTime::enabled()) return VirtualTime::advance(millis * 1000000);
     std::this_thread::sleep_for(std::chrono::milliseconds( millis ) / Clock::time_multiplier);
   }
 
   static void delaySeconds(double secs) {
+    if (VirtualTime::enabled()) return VirtualTime::advance(secs * 1000000000.0);
     std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(secs * 1000) / Clock::time_multiplier);
   }
 
@@ -0,0 +1,135 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "IOLoggerTrace.h"
+#include <signal.h>
+#include <pthread.h>
+
+IOLoggerTrace::IOLoggerTrace(std::string filename, uint8_t capacity_log2)
+  : ring(new Slot[1ULL << capacity_log2]), mask((1ULL << capacity_log2) - 1),
+    head(0), tail(0), dropped_events(0), dropped_written(0), last_timestamp(0), running(true)
+{
+  for (uint64_t i = 0; i <= mask; i++)
+    ring[i].sequence.store(i, std::memory_order_relaxed);
+
+  file = fopen(filename.c_str(), "wb");
+  if (file) {
+    const uint8_t header[] = { 'G', 'P', 'T', 'R', TRACE_VERSION };
+    fwrite(header, 1, sizeof(header), file);
+  }
+
+  out.reserve(64 * 1024);
+  flusher = std::thread(&IOLoggerTrace::flush_thread, this);
+}
+
+IOLoggerTrace::~IOLoggerTrace() {
+  running = false;
+  flusher.join();
+  if (file) fclose(file);
+}
+
+// bounded multi-producer ring: a slot is free for position p when its
+// sequence equals p, and readable once the producer has set it to p + 1.
+void IOLoggerTrace::log(GpioEvent ev) {
+  uint64_t pos = head.load(std::memory_order_relaxed);
+  for (;;) {
+    Slot &slot = ring[pos & mask];
+    const int64_t diff = int64_t(slot.sequence.load(std::memory_order_acquire) - pos);
+    if (diff == 0) {
+      if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        slot.timestamp = ev.timestamp;
+        slot.pin_id = ev.pin_id;
+        slot.event = ev.event;
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        return;
+      }
+    }
+    else if (diff < 0) {
+      // full -- the flusher has fallen behind.
+      dropped_events.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    else
+      pos = head.load(std::memory_order_relaxed);
+  }
+}
+
+void IOLoggerTrace::put_varint(uint64_t v) {
+  while (v >= 0x80) {
+    out.push_back(uint8_t(v) | 0x80);
+    v >>= 7;
+  }
+  out.push_back(uint8_t(v));
+}
+
+// encodes everything currently readable. Returns false if the ring was empty.
+bool IOLoggerTrace::drain() {
+  out.clear();
+
+  const uint64_t dropped_now = dropped();
+  if (dropped_now != dropped_written) {
+    put_varint(0);
+    out.push_back(0);
+    out.push_back(TRACE_OVERFLOW);
+    put_varint(dropped_now - dropped_written);
+    dropped_written = dropped_now;
+  }
+
+  for (;;) {
+    Slot &slot = ring[tail & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != tail + 1) break;
+
+    const int64_t delta = int64_t(slot.timestamp - last_timestamp);
+    last_timestamp = slot.timestamp;
+    put_varint((uint64_t(delta) << 1) ^ uint64_t(delta >> 63)); // zigzag
+    out.push_back(uint8_t(slot.pin_id));
+    out.push_back(slot.event);
+
+    slot.sequence.store(tail + mask + 1, std::memory_order_release);
+    tail++;
+
+    if (out.size() >= out.capacity() - 16) break;
+  }
+
+  if (out.empty()) return false;
+  if (file) {
+    fwrite(out.data(), 1, out.size(), file);
+    fflush(file);
+  }
+  return true;
+}
+
+void IOLoggerTrace::flush_thread() {
+  // keep the timer "interrupts" on the firmware threads.
+  sigset_t timer_signals;
+  sigemptyset(&timer_signals);
+  sigaddset(&timer_signals, SIGRTMIN);
+  pthread_sigmask(SIG_BLOCK, &timer_signals, nullptr);
+
+  while (running) {
+    if (!drain()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  while (drain()) { /* nada */ }
+}
+
+#endif // __PLAT_LINUX__
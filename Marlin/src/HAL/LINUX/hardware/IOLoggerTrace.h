@@ -0,0 +1,84 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+#include "Gpio.h"
+
+/**
+ * Binary GPIO trace, for capturing long runs at full speed.
+ *
+ * Gpio::set() is called from the firmware thread and from the timer signal
+ * handlers, which may interrupt it, so log() reserves ring slots with an atomic
+ * increment and never blocks: if the ring is full the event is dropped and counted.
+ * A background thread drains the ring and encodes it to the file.
+ *
+ * File format (see buildroot/share/scripts/gpio_trace.py):
+ *   header: "GPTR" version(u8)
+ *   event:  delta_ns(zigzag varint) pin(u8) type(u8)
+ *           delta_ns is relative to the previous event, and may be negative
+ *           when a signal handler's event was published out of order.
+ *   overflow marker: delta_ns(0) 0x00 TRACE_OVERFLOW dropped_count(varint)
+ */
+class IOLoggerTrace: public IOLogger {
+public:
+  static constexpr uint8_t TRACE_VERSION = 1;
+  static constexpr uint8_t TRACE_OVERFLOW = 0xFF;
+
+  IOLoggerTrace(std::string filename, uint8_t capacity_log2 = 20);
+  virtual ~IOLoggerTrace();
+  void log(GpioEvent ev);
+
+  bool is_open() { return file != nullptr; }
+  uint64_t dropped() { return dropped_events.load(std::memory_order_relaxed); }
+
+private:
+  struct Slot {
+    std::atomic<uint64_t> sequence;
+    uint64_t timestamp;
+    pin_type pin_id;
+    uint8_t event;
+  };
+
+  void flush_thread();
+  bool drain();
+  void put_varint(uint64_t v);
+
+  std::unique_ptr<Slot[]> ring;
+  const uint64_t mask;
+  std::atomic<uint64_t> head;   // next slot to reserve (producers)
+  uint64_t tail;                // next slot to read (flusher only)
+  std::atomic<uint64_t> dropped_events;
+  uint64_t dropped_written;
+
+  FILE* file;
+  std::vector<uint8_t> out;
+  uint64_t last_timestamp;
+
+  std::atomic<bool> running;
+  std::thread flusher;
+};
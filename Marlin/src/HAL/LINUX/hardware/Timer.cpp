@@ -23,9 +23,11 @@
 
 #include "Timer.h"
 #include <stdio.h>
+#include <algorithm>
 
 Timer::Timer() {
   active = false;
+  pending = false;
   compare = 0;
   frequency = 0;
   overruns = 0;
@@ -37,6 +39,7 @@ Timer::Timer() {
 }
 
 Timer::~Timer() {
+  if (VirtualTime::enabled()) return;
   timer_delete(timerid);
 }
 
@@ -47,6 +50,8 @@ void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
   frequency = sim_freq;
   cbfn = fn;
 
+  if (VirtualTime::enabled()) return;
+
   sa.sa_flags = SA_SIGINFO;
   sa.sa_sigaction = Timer::handler;
   sigemptyset(&sa.sa_mask);
@@ -73,6 +78,15 @@ void Timer::start(uint32_t frequency) {
 }
 
 void Timer::enable() {
+  if (VirtualTime::enabled()) {
+    active = true;
+    // a real timer would interrupt as soon as it is unmasked
+    if (pending) {
+      pending = false;
+      VirtualTime::schedule(this, VirtualTime::nanos());
+    }
+    return;
+  }
   if (sigprocmask(SIG_UNBLOCK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
@@ -81,6 +95,10 @@ void Timer::enable() {
 }
 
 void Timer::disable() {
+  if (VirtualTime::enabled()) {
+    active = false;
+    return;
+  }
   if (sigprocmask(SIG_SETMASK, &mask, nullptr) == -1) {
     return; // todo: handle error
   }
@@ -88,6 +106,14 @@ void Timer::disable() {
 }
 
 void Timer::setCompare(uint32_t compare) {
+  if (VirtualTime::enabled()) {
+    // the counter restarts at each match (CTC), so the next match is relative to the last one
+    this->compare = compare;
+    this->period = std::max<uint64_t>(Clock::ticksToNanos(compare, frequency), 1);
+    VirtualTime::schedule(this, std::max(start_time + period, VirtualTime::nanos()));
+    return;
+  }
+
   uint32_t nsec_offset = 0;
   if (active) {
     nsec_offset = Clock::nanos() - this->start_time; // calculate how long the timer would have been running for
@@ -110,6 +136,15 @@ void Timer::setCompare(uint32_t compare) {
   this->start_time = Clock::nanos();
 }
 
+void Timer::fire() {
+  start_time = VirtualTime::nanos();
+  if (active)
+    cbfn(); // (which usually sets the next compare)
+  else
+    pending = true;
+  if (!scheduled()) VirtualTime::schedule(this, start_time + period);
+}
+
 uint32_t Timer::getCount() {
   return Clock::nanosToTicks(Clock::nanos() - this->start_time, frequency);
 }
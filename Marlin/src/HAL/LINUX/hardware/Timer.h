@@ -30,7 +30,8 @@
 
 #include "Clock.h"
 
-class Timer {
+// In virtual time the Timer is an event on the VirtualTime queue rather than a POSIX timer.
+class Timer: public VirtualEvent {
 public:
   Timer();
   virtual ~Timer();
@@ -48,6 +49,8 @@ public:
   uint32_t getOverruns() {return overruns;}
   uint32_t getAvgError() {return avg_error;}
 
+  void fire();
+
   intptr_t getID() {
     return (*(intptr_t*)timerid);
   }
@@ -64,6 +67,7 @@ public:
 
 private:
   bool active;
+  bool pending;     // virtual time: compare matched while disabled
   uint32_t compare;
   uint32_t frequency;
   uint32_t overruns;
@@ -0,0 +1,67 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include "VirtualTime.h"
+
+bool VirtualTime::active = false;
+bool VirtualTime::irq_masked = false;
+bool VirtualTime::in_event = false;
+uint64_t VirtualTime::now = 0;
+uint64_t VirtualTime::read_cost = 1000;
+std::multimap<uint64_t, VirtualEvent*> VirtualTime::queue;
+
+void VirtualTime::schedule(VirtualEvent* ev, uint64_t when) {
+  cancel(ev);
+  ev->when = when;
+  ev->position = queue.emplace_hint(queue.upper_bound(when), when, ev);
+  ev->queued = true;
+}
+
+void VirtualTime::cancel(VirtualEvent* ev) {
+  if (!ev->queued) return;
+  queue.erase(ev->position);
+  ev->queued = false;
+}
+
+void VirtualTime::advance(uint64_t ns) {
+  const uint64_t target = now + ns;
+
+  if (!in_event && !irq_masked) {
+    in_event = true;
+    while (!queue.empty() && queue.begin()->first <= target) {
+      VirtualEvent* ev = queue.begin()->second;
+      queue.erase(queue.begin());
+      ev->queued = false;
+      if (ev->when > now) now = ev->when;
+
+      const bool masked = irq_masked;
+      ev->fire();
+      irq_masked = masked;
+    }
+    in_event = false;
+  }
+
+  if (target > now) now = target;
+}
+
+#endif // __PLAT_LINUX__
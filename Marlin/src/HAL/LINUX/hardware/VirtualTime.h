@@ -0,0 +1,75 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+#include <map>
+
+/**
+ * Discrete-event virtual time (--virtual-time).
+ *
+ * Nothing follows the wall clock: the Timer "interrupts" and the peripheral
+ * simulation are events on one queue, dispatched on the firmware thread in
+ * timestamp order. The firmware moves time forward by delaying and by reading
+ * millis()/micros() (each read costs a fixed quantum, so polling loops make
+ * progress), which runs as fast as the host allows and gives the same result on
+ * every run for the same input.
+ *
+ * Events never nest: time spent inside an event (e.g. DELAY_NS in the stepper
+ * ISR) accrues, and anything that fell due meanwhile is dispatched late, once
+ * the event returns -- as a real interrupt would be.
+ */
+class VirtualEvent {
+public:
+  virtual ~VirtualEvent() {}
+  virtual void fire() = 0;
+  bool scheduled() { return queued; }
+  uint64_t due() { return when; }
+
+private:
+  friend class VirtualTime;
+  bool queued = false;
+  uint64_t when = 0;
+  std::multimap<uint64_t, VirtualEvent*>::iterator position;
+};
+
+class VirtualTime {
+public:
+  static bool enabled() { return active; }
+  static void enable(uint64_t read_cost_ns) { active = true; read_cost = read_cost_ns; }
+  static uint64_t nanos() { return now; }
+
+  // (re)schedules ev at the absolute time when; events due at the same time run in the order they were scheduled.
+  static void schedule(VirtualEvent* ev, uint64_t when);
+  static void cancel(VirtualEvent* ev);
+
+  static void advance(uint64_t ns);
+  static void consume() { advance(read_cost); } // a firmware clock read / poll
+
+  // cli() / sei(): while masked, due events wait.
+  static void mask(bool masked) { irq_masked = masked; }
+
+private:
+  static bool active, irq_masked, in_event;
+  static uint64_t now, read_cost;
+  static std::multimap<uint64_t, VirtualEvent*> queue;
+};
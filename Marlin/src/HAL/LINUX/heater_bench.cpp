@@ -0,0 +1,164 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include <chrono>
+#include <vector>
+
+#include "../../inc/MarlinConfig.h"
+
+#if HAS_HOTEND && ENABLED(PIDTEMP) && ENABLED(HEATER_0_USES_THERMISTOR)
+
+#include "../../module/temperature.h"
+#include "../../module/thermistor/thermistors.h"
+#include <stdio.h>
+
+/**
+ * --bench-heater[=calls]
+ *
+ * Times Temperature::manage_heater() as built, with the hotends and bed read a couple of
+ * degrees either side of their targets (so the hotend PID runs), and reports microseconds
+ * per call. (build with RAPIDIA_FIXED_PID on, then off, to compare.)
+ *
+ * Then checks get_pid_output_hotend() against a copy of the float PID it replaces, over a
+ * simulated heat-up and hold, and reports PID updates per second for each. Returns nonzero if
+ * an output differs by more than a PWM step.
+ */
+
+// The raw value a table reads as the given temperature.
+static int16_t raw_for(const temp_entry_t * const tbl, const uint8_t len, const float celsius) {
+  for (uint8_t i = 1; i < len; i++) {
+    const float c0 = tbl[i - 1].celsius, c1 = tbl[i].celsius;
+    if (c0 != c1 && WITHIN(celsius, _MIN(c0, c1), _MAX(c0, c1)))
+      return tbl[i - 1].value + LROUND((celsius - c0) / (c1 - c0) * (tbl[i].value - tbl[i - 1].value));
+  }
+  return tbl[len - 1].value;
+}
+
+// get_pid_output_hotend() as it was: float, for hotend 0.
+struct FloatPID {
+  float iState = 0, dState = 0, work_Kd = 0;
+  bool reset = false;
+
+  float output(const float celsius, const int16_t target) {
+    const float pid_error = target - celsius;
+    float pid_output;
+    if (target == 0 || pid_error < -(PID_FUNCTIONAL_RANGE)) {
+      pid_output = 0;
+      reset = true;
+    }
+    else if (pid_error > PID_FUNCTIONAL_RANGE) {
+      pid_output = BANG_MAX;
+      reset = true;
+    }
+    else {
+      if (reset) {
+        iState = 0;
+        work_Kd = 0;
+        reset = false;
+      }
+      work_Kd = work_Kd + PID_K2 * (PID_PARAM(Kd, 0) * (dState - celsius) - work_Kd);
+      const float max_power_over_i_gain = float(PID_MAX) / PID_PARAM(Ki, 0) - float(MIN_POWER);
+      iState = constrain(iState + pid_error, 0, max_power_over_i_gain);
+      pid_output = PID_PARAM(Kp, 0) * pid_error + PID_PARAM(Ki, 0) * iState + work_Kd + float(MIN_POWER);
+      LIMIT(pid_output, 0, PID_MAX);
+    }
+    dState = celsius;
+    return pid_output;
+  }
+};
+
+static double seconds_since(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int bench_heater(const uint32_t calls) {
+  constexpr int16_t hotend_target = 210, bed_target = 60;
+
+  HOTEND_LOOP() {
+    PID_PARAM(Kp, e) = DEFAULT_Kp;
+    PID_PARAM(Ki, e) = scalePID_i(DEFAULT_Ki);
+    PID_PARAM(Kd, e) = scalePID_d(DEFAULT_Kd);
+  }
+  thermalManager.updatePID();
+
+  // A second of readings, swinging 2°C either side of the targets.
+  constexpr uint16_t readings = 1000;
+  std::vector<int16_t> hotend_raw(readings), bed_raw(readings);
+  for (uint16_t i = 0; i < readings; i++) {
+    const float swing = 2 * sinf(i * float(2 * M_PI) / readings);
+    hotend_raw[i] = raw_for(HEATER_0_TEMPTABLE, HEATER_0_TEMPTABLE_LEN, hotend_target + swing);
+    #if ENABLED(HEATER_BED_USES_THERMISTOR)
+      bed_raw[i] = raw_for(BED_TEMPTABLE, BED_TEMPTABLE_LEN, bed_target + swing);
+    #endif
+  }
+
+  HOTEND_LOOP() thermalManager.temp_hotend[e].target = hotend_target;
+  TERN_(HAS_HEATED_BED, thermalManager.temp_bed.target = bed_target);
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t c = 0; c < calls; c++) {
+    HOTEND_LOOP() thermalManager.temp_hotend[e].raw = hotend_raw[c % readings];
+    TERN_(HAS_HEATED_BED, thermalManager.temp_bed.raw = bed_raw[c % readings]);
+    Temperature::raw_temps_ready = true;
+    thermalManager.manage_heater();
+  }
+  const double manage_s = seconds_since(start);
+  printf("manage_heater(): %u calls in %.3fs, %.3fus per call (%s PID)\n",
+    unsigned(calls), manage_s, manage_s * 1e6 / calls, TERN(RAPIDIA_FIXED_PID, "fixed-point", "float"));
+  HOTEND_LOOP() thermalManager.temp_hotend[e].target = 0;
+  TERN_(HAS_HEATED_BED, thermalManager.temp_bed.target = 0);
+
+  // A heat-up from room temperature and a hold, the heater driven by the firmware's PID.
+  // (the float PID runs alongside, on the same readings.)
+  std::vector<float> trace;
+  trace.reserve(calls);
+  FloatPID float_pid;
+  float temp = 25, max_output_error = 0, checksum = 0;
+  thermalManager.temp_hotend[0].target = hotend_target;
+  for (uint32_t c = 0; c < calls; c++) {
+    // (read in 1/256ths of a degree, the fixed-point PID's resolution, so both take the same branch)
+    const float celsius = LROUND(temp * 256) * (1.0f / 256);
+    thermalManager.temp_hotend[0].celsius = celsius;
+    trace.push_back(celsius);
+    const float out = thermalManager.get_pid_output_hotend(0);
+    NOLESS(max_output_error, ABS(int(out) - int(float_pid.output(celsius, hotend_target))));
+    // (about 2.5°C/s flat out, losing 0.1% of the rise over the room per sample)
+    temp += out * (0.4f / 255) - (temp - 25) * 0.001f;
+    if (c % 2000 == 1999) temp -= 3; // (a draught)
+  }
+
+  auto updates = [&](const char * const name, auto &&output) {
+    start = std::chrono::steady_clock::now();
+    for (const float t : trace) checksum += output(t);
+    printf("%s: %.0f PID updates/s\n", name, trace.size() / seconds_since(start));
+  };
+  float_pid = FloatPID();
+  updates("PID before (float)", [&](const float t) { return float_pid.output(t, hotend_target); });
+  updates("PID after", [](const float t) {
+    thermalManager.temp_hotend[0].celsius = t;
+    return thermalManager.get_pid_output_hotend(0);
+  });
+  thermalManager.temp_hotend[0].target = 0;
+
+  printf("max PID output difference:%.0f (held at %.2fC) (checksum %.1f)\n", max_output_error, temp, checksum);
+  return max_output_error > 1;
+}
+
+#endif // HAS_HOTEND && PIDTEMP && HEATER_0_USES_THERMISTOR
+#endif // __PLAT_LINUX__
@@ -98,6 +98,7 @@ extern "C" {
 void _delay_ms(const int delay);
 void delayMicroseconds(unsigned long);
 uint32_t millis();
+uint32_t micros();
 
 //IO functions
 void pinMode(const pin_t, const uint8_t);
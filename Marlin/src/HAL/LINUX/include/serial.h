@@ -56,6 +56,15 @@ public:
     return buffer[mask(index_read++)];
   }
 
+  // Contiguous values from the read index, up to the end of the array (see skip).
+  uint32_t span(const T* &values) volatile {
+    const uint32_t r = mask(index_read);
+    values = const_cast<const T*>(buffer + r);
+    return _MIN(available(), buffer_size - r);
+  }
+
+  void skip(uint32_t n) volatile { index_read += n; }
+
   bool write(T value) volatile {
     if (full()) return false;
     buffer[mask(index_write++)] = value;
@@ -94,12 +103,24 @@ public:
 
   int read() { return receive_buffer.read(); }
 
+  // Block reads (see MarlinSerial::rx_span)
+  uint16_t rx_span(const uint8_t* &span) { return (uint16_t)receive_buffer.span(span); }
+  void rx_consume(const uint16_t n) { receive_buffer.skip(n); }
+
   size_t write(char c) {
     if (!host_connected) return 0;
     while (!transmit_buffer.free());
     return transmit_buffer.write(c);
   }
 
+  size_t write(const uint8_t* buffer, size_t size) {
+    if (!host_connected) return 0;
+    for (size_t i = 0; i < size;) {
+      if (transmit_buffer.write(buffer[i])) ++i;
+    }
+    return size;
+  }
+
   operator bool() { return host_connected; }
 
   uint16_t available() {
@@ -0,0 +1,272 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include <chrono>
+#include <vector>
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(RAPIDIA_ABL_PLANE_TABLE)
+
+#include "../../feature/bedlevel/bedlevel.h"
+#include <stdio.h>
+
+/**
+ * --bench-leveling[=passes]
+ *
+ * Levels a serpentine raster over the whole bed (1mm moves on lines 0.4mm apart,
+ * along X and then at 45°) against a synthetic warped grid. Each move is split
+ * on grid lines, and Z is looked up at every split:
+ *   before: a copy of the recursive splitter, with bilinear_z_offset_float()
+ *    after: bilinear_cell_walk(), with the plane table's bilinear_z_offset()
+ * Reports segments per second for each, and Z lookups per second alone (as
+ * SEGMENT_LEVELED_MOVES makes them). Returns nonzero if the two split a move
+ * differently, or their Z differs by more than a micron.
+ *
+ * With RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS, also splits 10mm moves per cell as
+ * segmented_line_to_destination() does, and reports the segments per move (against
+ * LEVELED_SEGMENT_LENGTH pieces) and how far they stray from the surface, which
+ * mustn't be more than RAPIDIA_LEVELED_SEGMENT_TOLERANCE.
+ */
+
+#if ENABLED(ABL_BILINEAR_SUBDIVISION)
+  #define BENCH_SUBDIVISIONS BILINEAR_SUBDIVISIONS
+#else
+  #define BENCH_SUBDIVISIONS 1
+#endif
+
+static constexpr uint8_t bench_points_x = (GRID_MAX_POINTS_X - 1) * (BENCH_SUBDIVISIONS) + 1,
+                         bench_points_y = (GRID_MAX_POINTS_Y - 1) * (BENCH_SUBDIVISIONS) + 1;
+static xy_pos_t bench_spacing;
+
+// bilinear_line_to_destination() as it was: recursive, splitting on the larger cell index of each crossing.
+static void split_recursive(xyze_pos_t &current, xyze_pos_t dest, void (*segment)(const xyze_pos_t &to),
+                            uint16_t x_splits=0xFFFF, uint16_t y_splits=0xFFFF) {
+  #define BENCH_CELL(A,V) ((V - bilinear_start.A) / bench_spacing.A)
+  xy_int_t c1 { int16_t(BENCH_CELL(x, current.x)), int16_t(BENCH_CELL(y, current.y)) },
+           c2 { int16_t(BENCH_CELL(x, dest.x)), int16_t(BENCH_CELL(y, dest.y)) };
+  LIMIT(c1.x, 0, bench_points_x - 2);
+  LIMIT(c1.y, 0, bench_points_y - 2);
+  LIMIT(c2.x, 0, bench_points_x - 2);
+  LIMIT(c2.y, 0, bench_points_y - 2);
+
+  if (c1 == c2) {
+    current = dest;
+    segment(current);
+    return;
+  }
+
+  #define LINE_SEGMENT_END(A) (current.A + (end.A - current.A) * normalized_dist)
+
+  float normalized_dist;
+  const xyze_pos_t end = dest;
+  const xy_int8_t gc { int8_t(_MAX(c1.x, c2.x)), int8_t(_MAX(c1.y, c2.y)) };
+
+  if (c2.x != c1.x && TEST(x_splits, gc.x)) {
+    CBI(x_splits, gc.x);
+    dest.x = bilinear_start.x + bench_spacing.x * gc.x;
+    normalized_dist = (dest.x - current.x) / (end.x - current.x);
+    dest.y = LINE_SEGMENT_END(y);
+  }
+  else if (c2.y != c1.y && TEST(y_splits, gc.y)) {
+    CBI(y_splits, gc.y);
+    dest.y = bilinear_start.y + bench_spacing.y * gc.y;
+    normalized_dist = (dest.y - current.y) / (end.y - current.y);
+    dest.x = LINE_SEGMENT_END(x);
+  }
+  else {
+    current = dest;
+    segment(current);
+    return;
+  }
+
+  dest.z = LINE_SEGMENT_END(z);
+  dest.e = LINE_SEGMENT_END(e);
+
+  split_recursive(current, dest, segment, x_splits, y_splits);
+  split_recursive(current, end, segment, x_splits, y_splits);
+}
+
+// A bed warped by up to about half a millimetre.
+static void bench_grid() {
+  bilinear_start.set(0, 0);
+  bilinear_grid_spacing.set(float(X_BED_SIZE) / (GRID_MAX_POINTS_X - 1), float(Y_BED_SIZE) / (GRID_MAX_POINTS_Y - 1));
+  bench_spacing = bilinear_grid_spacing / float(BENCH_SUBDIVISIONS);
+  GRID_LOOP(x, y) {
+    const float gx = x * bilinear_grid_spacing.x, gy = y * bilinear_grid_spacing.y;
+    z_values[x][y] = 0.3f * sinf(gx / 70) + 0.2f * cosf(gy / 50) + 0.1f * (gx / X_BED_SIZE) * (gy / Y_BED_SIZE) - 0.1f;
+  }
+  refresh_bed_level();
+}
+
+static std::vector<xyze_pos_t> bench_raster() {
+  std::vector<xyze_pos_t> raster;
+  xyze_pos_t p { 0, 0, 0.2f, 0 };
+  auto line = [&](const xy_pos_t &a, const xy_pos_t &b) {
+    const float len = SQRT(sq(b.x - a.x) + sq(b.y - a.y));
+    const uint16_t moves = _MAX(CEIL(len), 1);
+    // (a travel move to the start of the line, then 1mm extrusions.)
+    p.set(a.x, a.y);
+    raster.push_back(p);
+    for (uint16_t i = 1; i <= moves; i++) {
+      const float t = float(i) / moves;
+      p.set(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t);
+      p.e += 0.033f * len / moves;
+      raster.push_back(p);
+    }
+  };
+
+  constexpr float pitch = 0.4f, bx = X_BED_SIZE, by = Y_BED_SIZE;
+  bool reverse = false;
+  for (float y = pitch / 2; y < by; y += pitch, reverse = !reverse)
+    line({ reverse ? bx : 0, y }, { reverse ? 0 : bx, y });
+
+  // x - y = c, clipped to the bed
+  for (float c = pitch - by; c < bx; c += pitch * float(M_SQRT2), reverse = !reverse) {
+    const xy_pos_t a { _MAX(c, 0), _MAX(c, 0) - c }, b { _MIN(by + c, bx), _MIN(by + c, bx) - c };
+    line(reverse ? b : a, reverse ? a : b);
+  }
+  return raster;
+}
+
+static uint32_t segments;
+static float z_sum;
+static std::vector<xyze_pos_t> split_points;
+static std::vector<float> split_z;
+
+static void before_segment(const xyze_pos_t &to) { segments++; z_sum += bilinear_z_offset_float(to); }
+static void after_segment(const xyze_pos_t &to) { segments++; z_sum += bilinear_z_offset(to); }
+static xyze_pos_t split_from;
+
+// (a move from a grid line may or may not be split on it first, by rounding, so repeated points are left out.)
+static void record(const xyze_pos_t &to, const float z) {
+  const xyze_pos_t &prev = split_points.empty() ? split_from : split_points.back();
+  if (ABS(to.x - prev.x) < 0.0001f && ABS(to.y - prev.y) < 0.0001f) return;
+  split_points.push_back(to);
+  split_z.push_back(z);
+}
+static void record_before(const xyze_pos_t &to) { record(to, bilinear_z_offset_float(to)); }
+static void record_after(const xyze_pos_t &to) { record(to, bilinear_z_offset(to)); }
+
+#if ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+
+  static xyze_pos_t adaptive_from;
+  static uint32_t adaptive_segments;
+  static float max_stray;
+
+  static void adaptive_piece(const xyze_pos_t &to) {
+    const uint16_t n = bilinear_cell_segments(adaptive_from, to);
+    adaptive_segments += n;
+    const xyze_float_t step = (to - adaptive_from) * (1.0f / n);
+    xyze_pos_t a = adaptive_from;
+    for (uint16_t s = 0; s < n; s++) {
+      // (a segment strays from the surface most at its middle)
+      const xyze_pos_t mid = a + step * 0.5f, b = a + step;
+      NOLESS(max_stray, ABS((bilinear_z_offset_float(a) + bilinear_z_offset_float(b)) * 0.5f - bilinear_z_offset_float(mid)));
+      a = b;
+    }
+    adaptive_from = to;
+  }
+
+#endif
+
+static double seconds_since(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int bench_leveling(const uint32_t passes) {
+  bench_grid();
+  const std::vector<xyze_pos_t> raster = bench_raster();
+
+  // Check that the walker splits as the recursive splitter did, and that the table's Z agrees.
+  uint32_t wrong = 0;
+  float max_z_error = 0;
+  for (std::size_t i = 1; i < raster.size(); i++) {
+    split_from = raster[i - 1];
+    split_points.clear();
+    split_z.clear();
+    xyze_pos_t current = raster[i - 1];
+    split_recursive(current, raster[i], record_before);
+    const std::vector<xyze_pos_t> before_points = split_points;
+    const std::vector<float> before_z = split_z;
+
+    split_points.clear();
+    split_z.clear();
+    bilinear_cell_walk(raster[i - 1], raster[i], record_after);
+
+    bool same = split_points.size() == before_points.size();
+    for (std::size_t s = 0; same && s < split_points.size(); s++) {
+      LOOP_XYZ(a) if (ABS(split_points[s][a] - before_points[s][a]) > 0.0001f) same = false;
+      // (E runs to thousands of mm over the raster, where a float is only good to about 0.0005)
+      if (ABS(split_points[s].e - before_points[s].e) > 0.002f) same = false;
+      NOLESS(max_z_error, ABS(split_z[s] - before_z[s]));
+    }
+    if (!same && wrong++ < 10)
+      fprintf(stderr, "split differs: (%.3f,%.3f)->(%.3f,%.3f) %u vs %u segments\n",
+        raster[i - 1].x, raster[i - 1].y, raster[i].x, raster[i].y, unsigned(split_points.size()), unsigned(before_points.size()));
+  }
+
+  auto bench = [&](const char * const name, void (*split)(const xyze_pos_t &from, const xyze_pos_t &to)) {
+    segments = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t p = 0; p < passes; p++)
+      for (std::size_t i = 1; i < raster.size(); i++) split(raster[i - 1], raster[i]);
+    const double s = seconds_since(start);
+    printf("%s: %u segments in %.3fs, %.0f segments/s\n", name, segments, s, segments / s);
+    return segments / s;
+  };
+  const double before = bench("before (recursive, float)", [](const xyze_pos_t &from, const xyze_pos_t &to) {
+    xyze_pos_t current = from;
+    split_recursive(current, to, before_segment);
+  });
+  const double after = bench("after (walker, plane table)", [](const xyze_pos_t &from, const xyze_pos_t &to) {
+    bilinear_cell_walk(from, to, after_segment);
+  });
+
+  auto lookups = [&](const char * const name, float (*z_offset)(const xy_pos_t &raw)) {
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t p = 0; p < passes; p++) for (const xyze_pos_t &pos : raster) z_sum += z_offset(pos);
+    const double s = seconds_since(start);
+    printf("%s: %.0f Z lookups/s\n", name, passes * raster.size() / s);
+  };
+  lookups("before (float)", bilinear_z_offset_float);
+  lookups("after (plane table)", bilinear_z_offset);
+
+  printf("grid:%ux%u raster:%u moves speedup:%.2fx split differs:%u max z difference:%.2fum (checksum %.1f)\n",
+    bench_points_x, bench_points_y, unsigned(raster.size() - 1), after / before, wrong, max_z_error * 1000, z_sum);
+
+  #if ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+    uint32_t moves = 0, fixed_segments = 0;
+    for (std::size_t i = 10; i < raster.size(); i += 10, moves++) {
+      adaptive_from = raster[i - 10];
+      bilinear_cell_walk(raster[i - 10], raster[i], adaptive_piece);
+      fixed_segments += _MAX(uint16_t(xyz_float_t(raster[i] - raster[i - 10]).magnitude() / (LEVELED_SEGMENT_LENGTH)), 1);
+    }
+    printf("10mm moves:%u segments per move: adaptive %.3f, fixed %.3f; max stray %.2fum (tolerance %.2fum)\n",
+      moves, float(adaptive_segments) / moves, float(fixed_segments) / moves, max_stray * 1000, (RAPIDIA_LEVELED_SEGMENT_TOLERANCE) * 1000);
+    // (the float lookup's own rounding is allowed for)
+    if (max_stray > (RAPIDIA_LEVELED_SEGMENT_TOLERANCE) + 0.0001f) wrong++;
+  #endif
+
+  return (wrong || max_z_error > 0.001f) ? 1 : 0;
+}
+
+#endif // RAPIDIA_ABL_PLANE_TABLE
+#endif // __PLAT_LINUX__
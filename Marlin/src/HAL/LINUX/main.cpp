@@ -22,27 +22,41 @@
 extern void setup();
 extern void loop();
 
+#include <atomic>
 #include <thread>
 
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <string>
 
 #include "../../inc/MarlinConfig.h"
 #include <stdio.h>
 #include <stdarg.h>
 #include "../shared/Delay.h"
 #include "hardware/IOLoggerCSV.h"
+#include "hardware/IOLoggerTrace.h"
 #include "hardware/Heater.h"
 #include "hardware/LinearAxis.h"
+#include "../../gcode/queue.h"
+#include "../../module/planner.h"
+
+extern int check_trapezoids(const uint32_t blocks);
+extern int bench_leveling(const uint32_t passes);
+extern int bench_heater(const uint32_t calls);
 
 // simple stdout / stdin implementation for fake serial port
+static std::atomic<bool> serial_running(true);
+
 void write_serial_thread() {
   for (;;) {
     for (std::size_t i = usb_serial.transmit_buffer.available(); i > 0; i--) {
       fputc(usb_serial.transmit_buffer.read(), stdout);
     }
+    if (!serial_running && !usb_serial.transmit_buffer.available()) break;
     std::this_thread::yield();
   }
+  fflush(stdout);
 }
 
 void read_serial_thread() {
@@ -56,28 +70,59 @@ void read_serial_thread() {
   }
 }
 
-void simulation_loop() {
-  Heater hotend(HEATER_0_PIN, TEMP_0_PIN);
-  Heater bed(HEATER_BED_PIN, TEMP_BED_PIN);
-  LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
-  LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
-  LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
-  LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
+// GPIO capture selected on the command line.
+static enum class GpioCapture { NONE, CSV, TRACE } gpio_capture = GpioCapture::NONE;
+static std::string gpio_capture_file;
 
-  //#define GPIO_LOGGING // Full GPIO and Positional Logging
+// Virtual time (--virtual-time), and the cost of one millis()/micros() read in it.
+static bool virtual_time = false;
+static uint64_t virtual_read_cost_ns = 1000;
 
-  #ifdef GPIO_LOGGING
-    IOLoggerCSV logger("all_gpio_log.csv");
-    Gpio::attachLogger(&logger);
+// Blocks to check planner trapezoids over (--check-trapezoids), instead of running the firmware.
+static uint32_t trapezoid_check_blocks = 0;
 
-    std::ofstream position_log;
-    position_log.open("axis_position_log.csv");
+// Passes to benchmark leveled moves over (--bench-leveling), instead of running the firmware.
+static uint32_t leveling_bench_passes = 0;
 
-    int32_t x,y,z;
-  #endif
+// manage_heater() calls to benchmark (--bench-heater), instead of running the firmware.
+static uint32_t heater_bench_calls = 0;
 
-  for (;;) {
+/**
+ * The simulated machine. Updated continuously by simulation_loop(), or
+ * in virtual time by a periodic event.
+ */
+class Simulation: public VirtualEvent {
+public:
+  static constexpr uint64_t VIRTUAL_PERIOD_NS = 1000000;
+
+  Heater hotend, bed;
+  LinearAxis x_axis, y_axis, z_axis, extruder0;
+
+  Simulation()
+    : hotend(HEATER_0_PIN, TEMP_0_PIN),
+      bed(HEATER_BED_PIN, TEMP_BED_PIN),
+      x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN),
+      y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN),
+      z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN),
+      extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC)
+  {
+    // Full GPIO and Positional Logging (--gpio-log)
+    if (gpio_capture == GpioCapture::CSV) {
+      logger.reset(new IOLoggerCSV(gpio_capture_file));
+      Gpio::attachLogger(logger.get());
+      position_log.open("axis_position_log.csv");
+    }
+    // Binary GPIO trace (--gpio-trace), flushed by its own thread
+    else if (gpio_capture == GpioCapture::TRACE) {
+      tracer.reset(new IOLoggerTrace(gpio_capture_file));
+      if (tracer->is_open())
+        Gpio::attachLogger(tracer.get());
+      else
+        fprintf(stderr, "Unable to open GPIO trace file %s\n", gpio_capture_file.c_str());
+    }
+  }
 
+  void update() {
     hotend.update();
     bed.update();
 
@@ -86,9 +131,9 @@ void simulation_loop() {
     z_axis.update();
     extruder0.update();
 
-    #ifdef GPIO_LOGGING
+    if (logger) {
       if (x_axis.position != x || y_axis.position != y || z_axis.position != z) {
-        uint64_t update = MAX3(x_axis.last_update, y_axis.last_update, z_axis.last_update);
+        uint64_t update = _MAX(x_axis.last_update, y_axis.last_update, z_axis.last_update);
         position_log << update << ", " << x_axis.position << ", " << y_axis.position << ", " << z_axis.position << std::endl;
         position_log.flush();
         x = x_axis.position;
@@ -96,16 +141,130 @@ void simulation_loop() {
         z = z_axis.position;
       }
       // flush the logger
-      logger.flush();
-    #endif
+      logger->flush();
+    }
+  }
+
+  void fire() {
+    update();
+    VirtualTime::schedule(this, due() + VIRTUAL_PERIOD_NS);
+  }
+
+private:
+  std::unique_ptr<IOLoggerCSV> logger;
+  std::ofstream position_log;
+  int32_t x = 0, y = 0, z = 0;
+  std::unique_ptr<IOLoggerTrace> tracer;
+};
 
+void simulation_loop() {
+  Simulation simulation;
+  for (;;) {
+    simulation.update();
     std::this_thread::yield();
   }
 }
 
-int main() {
+/**
+ * Virtual time: stdin is read on the firmware thread, a line at a time as the
+ * receive buffer drains, so commands arrive at the same virtual time on every run.
+ * Returns false once input has ended and everything queued has been executed.
+ */
+static bool virtual_serial_input() {
+  static std::string line;
+  static std::size_t sent = 0;
+  static bool input_ended = false;
+
+  while (!input_ended || sent < line.size()) {
+    if (sent == line.size()) {
+      // (not fgets: binary frames may contain NULs.)
+      line.clear();
+      sent = 0;
+      for (int c; line.size() < 254 && (c = getchar()) != EOF;) {
+        line += char(c);
+        if (c == '\n') break;
+      }
+      if (line.empty()) { input_ended = true; break; }
+    }
+    // (a line that doesn't fit is finished on a later pass.)
+    while (sent < line.size() && usb_serial.receive_buffer.write(line[sent])) sent++;
+    if (sent < line.size()) return true;
+  }
+
+  return usb_serial.receive_buffer.available() || queue.has_commands_queued() || planner.has_blocks_queued();
+}
+
+// --gpio-log[=file]     CSV log of all GPIO events, plus axis_position_log.csv (slow)
+// --gpio-trace[=file]   binary GPIO trace (see hardware/IOLoggerTrace.h)
+// --virtual-time[=ns]   deterministic, faster-than-real-time clock (see hardware/VirtualTime.h);
+//                       ns is the cost of a millis()/micros() read (default 1000). Exits at the end of stdin.
+// --check-trapezoids[=n] checks fixed-point trapezoids over n random blocks (default 1000000) and exits
+//                       (see trapezoid_check.cpp)
+// --bench-leveling[=n]  times leveled moves over n passes of a full-bed raster (default 20) and exits
+//                       (see leveling_bench.cpp)
+// --bench-heater[=n]    times n manage_heater() calls (default 1000000), checks the hotend
+//                       PID against float, and exits (see heater_bench.cpp)
+static void parse_args(int argc, char* argv[]) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    auto value = [&](const char* name, std::string& val) {
+      const std::string prefix = name;
+      if (arg != prefix && arg.compare(0, prefix.size() + 1, prefix + "=") != 0) return false;
+      val = arg.size() > prefix.size() ? arg.substr(prefix.size() + 1) : "";
+      return true;
+    };
+    auto option = [&](const char* name, GpioCapture capture, const char* default_file) {
+      if (!value(name, gpio_capture_file)) return false;
+      gpio_capture = capture;
+      if (gpio_capture_file.empty()) gpio_capture_file = default_file;
+      return true;
+    };
+    std::string val;
+    if (option("--gpio-log", GpioCapture::CSV, "all_gpio_log.csv")) continue;
+    if (option("--gpio-trace", GpioCapture::TRACE, "gpio_trace.bin")) continue;
+    if (value("--virtual-time", val)) {
+      virtual_time = true;
+      if (!val.empty()) virtual_read_cost_ns = _MAX(strtoull(val.c_str(), nullptr, 10), 1ULL);
+      continue;
+    }
+    #if ENABLED(RAPIDIA_FIXED_TRAPEZOID)
+      if (value("--check-trapezoids", val)) {
+        trapezoid_check_blocks = val.empty() ? 1000000 : strtoul(val.c_str(), nullptr, 10);
+        continue;
+      }
+    #endif
+    #if ENABLED(RAPIDIA_ABL_PLANE_TABLE)
+      if (value("--bench-leveling", val)) {
+        leveling_bench_passes = val.empty() ? 20 : strtoul(val.c_str(), nullptr, 10);
+        continue;
+      }
+    #endif
+    #if HAS_HOTEND && ENABLED(PIDTEMP) && ENABLED(HEATER_0_USES_THERMISTOR)
+      if (value("--bench-heater", val)) {
+        heater_bench_calls = val.empty() ? 1000000 : _MAX(strtoul(val.c_str(), nullptr, 10), 1UL);
+        continue;
+      }
+    #endif
+    fprintf(stderr, "Unknown option %s\n", argv[i]);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  parse_args(argc, argv);
+  #if ENABLED(RAPIDIA_FIXED_TRAPEZOID)
+    if (trapezoid_check_blocks) return check_trapezoids(trapezoid_check_blocks);
+  #endif
+  #if ENABLED(RAPIDIA_ABL_PLANE_TABLE)
+    if (leveling_bench_passes) return bench_leveling(leveling_bench_passes);
+  #endif
+  #if HAS_HOTEND && ENABLED(PIDTEMP) && ENABLED(HEATER_0_USES_THERMISTOR)
+    if (heater_bench_calls) return bench_heater(heater_bench_calls);
+  #endif
+  if (virtual_time) VirtualTime::enable(virtual_read_cost_ns);
+
   std::thread write_serial (write_serial_thread);
-  std::thread read_serial (read_serial_thread);
+  std::thread read_serial;
+  if (!virtual_time) read_serial = std::thread(read_serial_thread);
 
   #if NUM_SERIAL > 0
     MYSERIAL0.begin(BAUDRATE);
@@ -118,6 +277,24 @@ int main() {
 
   HAL_timer_init();
 
+  if (virtual_time) {
+    Simulation simulation;
+    VirtualTime::schedule(&simulation, VirtualTime::nanos());
+
+    DELAY_US(10000);
+
+    setup();
+    do {
+      loop();
+      VirtualTime::consume();
+    } while (virtual_serial_input());
+
+    VirtualTime::cancel(&simulation);
+    serial_running = false;
+    write_serial.join();
+    return 0;
+  }
+
   std::thread simulation (simulation_loop);
 
   DELAY_US(10000);
@@ -0,0 +1,132 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifdef __PLAT_LINUX__
+
+#include <random>
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(RAPIDIA_FIXED_TRAPEZOID)
+
+#include "../../module/planner.h"
+#include <stdio.h>
+
+/**
+ * --check-trapezoids[=blocks]
+ *
+ * Runs randomized blocks through Planner::trapezoid_steps_fixed(), checks its
+ * accelerate/decelerate step counts against the same formulas taken exactly in
+ * 64-bit arithmetic, and reports how often (and by how much) they differ from
+ * trapezoid_steps_float(). Returns nonzero if the fixed-point counts are ever
+ * wrong. (the seed is fixed, so every run checks the same blocks.)
+ */
+
+struct TrapezoidSteps {
+  uint32_t accelerate, decelerate;
+  bool plateau;
+};
+
+// ceil(num / den) for den > 0
+static int64_t ceil_div(const int64_t num, const int64_t den) {
+  return num >= 0 ? (num + den - 1) / den : -((-num) / den);
+}
+
+static TrapezoidSteps exact_steps(const uint32_t nominal_rate, const uint32_t initial_rate, const uint32_t final_rate,
+                                  const int32_t accel, const uint32_t step_event_count) {
+  const int64_t n2 = int64_t(nominal_rate) * nominal_rate, i2 = int64_t(initial_rate) * initial_rate,
+                f2 = int64_t(final_rate) * final_rate, d = step_event_count;
+  const int64_t accelerate = ceil_div(n2 - i2, 2 * int64_t(accel)),
+                decelerate = (n2 - f2) / (2 * int64_t(accel));
+  if (accelerate + decelerate <= d)
+    return { uint32_t(accelerate), uint32_t(decelerate), true };
+  const int64_t intersection = ceil_div(2 * accel * d - i2 + f2, 4 * int64_t(accel));
+  const uint32_t accelerate_until = uint32_t(_MIN(_MAX(intersection, 0), d));
+  return { accelerate_until, uint32_t(d - accelerate_until), false };
+}
+
+template<typename F>
+static TrapezoidSteps planner_steps(F steps, const uint32_t nominal_rate, const uint32_t initial_rate, const uint32_t final_rate,
+                                    const int32_t accel, const uint32_t step_event_count) {
+  uint32_t accelerate_steps, plateau_steps;
+  const bool plateau = steps(accelerate_steps, plateau_steps, nominal_rate, initial_rate, final_rate, accel, step_event_count);
+  return { accelerate_steps, step_event_count - accelerate_steps - plateau_steps, plateau };
+}
+
+struct Differences {
+  uint32_t count = 0, max = 0;
+  void add(const uint32_t a, const uint32_t b) {
+    if (a == b) return;
+    count++;
+    NOLESS(max, a > b ? a - b : b - a);
+  }
+};
+
+int check_trapezoids(const uint32_t blocks) {
+  std::mt19937 rng(20200815);
+  auto uniform = [&](const float lo, const float hi) { return std::uniform_real_distribution<float>(lo, hi)(rng); };
+  auto log_uniform = [&](const float lo, const float hi) { return expf(uniform(logf(lo), logf(hi))); };
+
+  uint32_t plateaus = 0, fallbacks = 0, wrong = 0;
+  Differences accelerate, decelerate;
+
+  for (uint32_t b = 0; b < blocks; b++) {
+    // a block as _buffer_steps() would make it, and rates as calculate_trapezoid_for_block() would.
+    // (up to 50000 steps/s, so a few blocks are past the fixed-point range.)
+    const float steps_per_mm = log_uniform(5, 3200), millimeters = log_uniform(0.01, 200),
+                feedrate = _MIN(log_uniform(1, 500), log_uniform(20000, 50000) / steps_per_mm);
+    const uint32_t nominal_rate = _MAX(CEIL(feedrate * steps_per_mm), 1),
+                   step_event_count = _MAX(LROUND(millimeters * steps_per_mm), 1);
+    const int32_t accel = CEIL(log_uniform(10, 20000) * steps_per_mm);
+    // (entry and exit at nominal speed, and at a standstill, come up often.)
+    auto factor = [&]{ const float f = uniform(-0.2, 1.2); return constrain(f, 0, 1); };
+    const uint32_t initial_rate = _MAX(CEIL(nominal_rate * factor()), 120),
+                   final_rate = _MAX(CEIL(nominal_rate * factor()), 120);
+
+    const TrapezoidSteps fixed = planner_steps(Planner::trapezoid_steps_fixed, nominal_rate, initial_rate, final_rate, accel, step_event_count),
+                         flt = planner_steps(Planner::trapezoid_steps_float, nominal_rate, initial_rate, final_rate, accel, step_event_count);
+
+    // (outside the fixed-point range, trapezoid_steps_fixed is trapezoid_steps_float.)
+    if (nominal_rate > 46340 || initial_rate > nominal_rate || final_rate > nominal_rate) {
+      fallbacks++;
+      if (fixed.accelerate != flt.accelerate || fixed.decelerate != flt.decelerate) wrong++;
+      continue;
+    }
+
+    const TrapezoidSteps exact = exact_steps(nominal_rate, initial_rate, final_rate, accel, step_event_count);
+    if (fixed.accelerate != exact.accelerate || fixed.decelerate != exact.decelerate || fixed.plateau != exact.plateau) {
+      if (wrong++ < 10)
+        fprintf(stderr, "trapezoid n:%u i:%u f:%u a:%d d:%u fixed:%u/%u exact:%u/%u\n",
+          nominal_rate, initial_rate, final_rate, accel, step_event_count,
+          fixed.accelerate, fixed.decelerate, exact.accelerate, exact.decelerate);
+    }
+
+    if (fixed.plateau) plateaus++;
+    accelerate.add(fixed.accelerate, flt.accelerate);
+    decelerate.add(fixed.decelerate, flt.decelerate);
+  }
+
+  printf("trapezoids:%u plateau:%u no plateau:%u float fallback:%u wrong:%u\n",
+    blocks, plateaus, blocks - plateaus - fallbacks, fallbacks, wrong);
+  printf("differ from float: accelerate:%u (max %u steps) decelerate:%u (max %u steps)\n",
+    accelerate.count, accelerate.max, decelerate.count, decelerate.max);
+  return wrong ? 1 : 0;
+}
+
+#endif // RAPIDIA_FIXED_TRAPEZOID
+#endif // __PLAT_LINUX__
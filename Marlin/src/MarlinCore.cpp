@@ -54,6 +54,7 @@
 #include "feature/rapidia/heartbeat.h"
 #include "feature/rapidia/pause.h"
 #include "feature/rapidia/mileage.h"
+#include "feature/rapidia/task_profiler.h"
 #include "feature/rapidia/stack_util.h"
 
 #if ENABLED(RAPIDIA_KILL_RECOVERY)
@@ -527,7 +528,10 @@ void hard_reset_bl()
  */
 inline void manage_inactivity(const bool ignore_stepper_queue=false) {
 
-  if (queue.length < BUFSIZE) queue.get_available_commands();
+  // (with RAPIDIA_RX_STAGING, serial input is read into the staging lines even when the queue is full.)
+  if (TERN(RAPIDIA_RX_STAGING, true, queue.length < BUFSIZE)) queue.get_available_commands();
+  // (a full queue counts as serviced: no command could be accepted anyway.)
+  TERN_(RAPIDIA_TASK_PROFILER, Rapidia::TaskProfiler::serial_serviced());
 
   const millis_t ms = millis();
 
@@ -742,11 +746,17 @@ inline void manage_inactivity(const bool ignore_stepper_queue=false) {
  */
 void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
 
+  #if ENABLED(RAPIDIA_TASK_PROFILER)
+    Rapidia::IdleTaskTimer task_timer;
+  #endif
+
   // Core Marlin activities
   manage_inactivity(TERN_(ADVANCED_PAUSE_FEATURE, no_stepper_sleep));
+  RAPIDIA_TASK_LAP(TASK_INACTIVITY);
 
   // Manage Heaters (and Watchdog)
   thermalManager.manage_heater();
+  RAPIDIA_TASK_LAP(TASK_HEATER);
 
   // Max7219 heartbeat, animation, etc
   TERN_(MAX7219_DEBUG, max7219.idle_tasks());
@@ -779,12 +789,16 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
         if (endstops.tmc_spi_homing_check()) break;
   #endif
 
+  RAPIDIA_TASK_LAP(TASK_OTHER);
+
   #if ENABLED(RAPIDIA_PAUSE)
     Rapidia::pause.process_deferred();
+    RAPIDIA_TASK_LAP(TASK_PAUSE);
   #endif
 
   #if ENABLED(RAPIDIA_NOZZLE_PLUG_HYSTERESIS)
     endstops.update_z_max_hysteresis_core();
+    RAPIDIA_TASK_LAP(TASK_NOZZLE_PLUG);
   #endif
 
   if (emu_hook_sd_card_enabled)
@@ -792,8 +806,13 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
     // Handle SD Card insert / remove
     TERN_(SDSUPPORT, card.manage_media());
 
+    // Read the file being printed ahead of the queue
+    TERN_(RAPIDIA_SD_READ_AHEAD, card.read_ahead());
+
     // Handle USB Flash Drive insert / remove
     TERN_(USB_FLASH_DRIVE_SUPPORT, Sd2Card::idle());
+
+    RAPIDIA_TASK_LAP(TASK_MEDIA);
   }
 
   // Announce Host Keepalive state (if any)
@@ -805,8 +824,11 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
   // Update the Beeper queue
   TERN_(USE_BEEPER, buzzer.tick());
 
+  RAPIDIA_TASK_LAP(TASK_OTHER);
+
   // Handle UI input / draw events
   TERN(DWIN_CREALITY_LCD, DWIN_Update(), ui.update());
+  RAPIDIA_TASK_LAP(TASK_UI);
 
   // Run i2c Position Encoders
   #if ENABLED(I2C_POSITION_ENCODERS)
@@ -829,10 +851,14 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
       #endif
       TERN_(AUTO_REPORT_SD_STATUS, card.auto_report_sd_status());
       }
+    RAPIDIA_TASK_LAP(TASK_REPORT);
   #endif
 
   // update Mileage
-  TERN_(RAPIDIA_MILEAGE, Rapidia::mileage.update());
+  #if ENABLED(RAPIDIA_MILEAGE)
+    Rapidia::mileage.update();
+    RAPIDIA_TASK_LAP(TASK_MILEAGE);
+  #endif
 
   #ifdef HAL_IDLETASK
     HAL_idletask();
@@ -841,6 +867,12 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
   #if ENABLED(RAPIDIA_LINE_AUTO_REPORTING)
   {
     long last_source_line = planner.clear_last_source_line();
+    #if ENABLED(RAPIDIA_BATCHED_OK)
+      // (batched, the finished line shares the ack line.)
+      if (queue.ok_batching)
+        queue.report_oks(planner.auto_report_line_finished ? last_source_line : NO_SOURCE_LINE);
+      else
+    #endif
     if (planner.auto_report_line_finished)
     {
       if (last_source_line != NO_SOURCE_LINE)
@@ -849,6 +881,7 @@ void idle(TERN_(ADVANCED_PAUSE_FEATURE, bool no_stepper_sleep/*=false*/)) {
         SERIAL_ECHOLN(last_source_line);
       }
     }
+    RAPIDIA_TASK_LAP(TASK_LINE_REPORT);
   }
   #endif
 
@@ -236,12 +236,6 @@ void print_bilinear_leveling_grid() {
   }
 #endif // ABL_BILINEAR_SUBDIVISION
 
-// Refresh after other values have been updated
-void refresh_bed_level() {
-  bilinear_grid_factor = bilinear_grid_spacing.reciprocal();
-  TERN_(ABL_BILINEAR_SUBDIVISION, bed_level_virt_interpolate());
-}
-
 #if ENABLED(ABL_BILINEAR_SUBDIVISION)
   #define ABL_BG_SPACING(A) bilinear_grid_spacing_virt.A
   #define ABL_BG_FACTOR(A)  bilinear_grid_factor_virt.A
@@ -256,8 +250,115 @@ void refresh_bed_level() {
   #define ABL_BG_GRID(X,Y)  z_values[X][Y]
 #endif
 
+#if ENABLED(RAPIDIA_ABL_PLANE_TABLE)
+
+  /**
+   * Each grid cell's bilinear surface, z = a + b*u + c*v + d*u*v for u and v the
+   * fraction of the way across the cell in X and Y, taken from its corners when
+   * the grid changes. Coefficients are in 1/4096 mm (so within about 8mm) and the
+   * fractions in 1/16384 of a cell, so Z is looked up in integer arithmetic.
+   */
+  #define PLANE_Z_BITS        12
+  #define PLANE_FRACTION_BITS 14
+
+  typedef struct { int16_t a, b, c, d; } bilinear_plane_t;
+
+  static bilinear_plane_t bilinear_planes[ABL_BG_POINTS_X - 1][ABL_BG_POINTS_Y - 1];
+  static xy_float_t bilinear_plane_factor;  // Cell fractions per mm
+  static bool bilinear_planes_valid;        // False until built, or if a coefficient is out of range
+
+  #if ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+    // The most a straight line across each cell strays from its surface (the diagonals, by |d|/4)
+    static float bilinear_cell_deviation[ABL_BG_POINTS_X - 1][ABL_BG_POINTS_Y - 1];
+  #endif
+
+  static void bilinear_plane_table_build() {
+    bilinear_plane_factor = xy_float_t({ ABL_BG_FACTOR(x), ABL_BG_FACTOR(y) }) * float(_BV32(PLANE_FRACTION_BITS));
+    bilinear_planes_valid = true;
+    LOOP_L_N(x, ABL_BG_POINTS_X - 1)
+      LOOP_L_N(y, ABL_BG_POINTS_Y - 1) {
+        const float z1 = ABL_BG_GRID(x, y),     z2 = ABL_BG_GRID(x, y + 1),
+                    z3 = ABL_BG_GRID(x + 1, y), z4 = ABL_BG_GRID(x + 1, y + 1);
+        const float coeff[4] = { z1, z3 - z1, z2 - z1, z4 - z3 - z2 + z1 };
+        int16_t q[4];
+        LOOP_L_N(i, 4) {
+          const float f = coeff[i] * float(_BV(PLANE_Z_BITS));
+          // (an unprobed or wild grid falls back to the float lookup)
+          if (WITHIN(f, -32767, 32767))
+            q[i] = LROUND(f);
+          else {
+            q[i] = 0;
+            bilinear_planes_valid = false;
+          }
+        }
+        bilinear_planes[x][y] = { q[0], q[1], q[2], q[3] };
+        TERN_(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS, bilinear_cell_deviation[x][y] = ABS(coeff[3]) * 0.25f);
+      }
+  }
+
+#endif
+
+// Refresh after other values have been updated
+void refresh_bed_level() {
+  bilinear_grid_factor = bilinear_grid_spacing.reciprocal();
+  TERN_(ABL_BILINEAR_SUBDIVISION, bed_level_virt_interpolate());
+  TERN_(RAPIDIA_ABL_PLANE_TABLE, bilinear_plane_table_build());
+}
+
+#if ENABLED(RAPIDIA_ABL_PLANE_TABLE)
+
+  // A fraction of a cell of a coefficient, rounded
+  static inline int32_t plane_fraction(const int32_t coeff, const int16_t fraction) {
+    return (coeff * fraction + _BV32(PLANE_FRACTION_BITS - 1)) >> PLANE_FRACTION_BITS;
+  }
+
+  // Get the Z adjustment for non-linear bed leveling from the plane table
+  float bilinear_z_offset(const xy_pos_t &raw) {
+    if (!bilinear_planes_valid) return bilinear_z_offset_float(raw);
+
+    // Position in cell fractions, held within the grid. (Beyond it, the edge's height is kept.)
+    const xy_pos_t rel = (raw - bilinear_start.asFloat()) * bilinear_plane_factor;
+    constexpr int32_t max_x = int32_t(ABL_BG_POINTS_X - 1) << PLANE_FRACTION_BITS,
+                      max_y = int32_t(ABL_BG_POINTS_Y - 1) << PLANE_FRACTION_BITS;
+    const int32_t qx = rel.x <= 0 ? 0 : rel.x >= max_x ? max_x : int32_t(rel.x),
+                  qy = rel.y <= 0 ? 0 : rel.y >= max_y ? max_y : int32_t(rel.y);
+
+    const uint8_t gx = _MIN(qx >> PLANE_FRACTION_BITS, ABL_BG_POINTS_X - 2),
+                  gy = _MIN(qy >> PLANE_FRACTION_BITS, ABL_BG_POINTS_Y - 2);
+    const int16_t u = qx - (int32_t(gx) << PLANE_FRACTION_BITS),
+                  v = qy - (int32_t(gy) << PLANE_FRACTION_BITS);
+
+    const bilinear_plane_t &p = bilinear_planes[gx][gy];
+    const int32_t left = p.a + plane_fraction(p.c, v),   // Z on the cell's left edge
+                  slope = p.b + plane_fraction(p.d, v);  // Z across the cell in X
+    return (left + plane_fraction(slope, u)) * (1.0f / _BV(PLANE_Z_BITS));
+  }
+
+#endif
+
+#if ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+
+  static_assert(RAPIDIA_LEVELED_SEGMENT_TOLERANCE > 0, "RAPIDIA_LEVELED_SEGMENT_TOLERANCE must be greater than 0.");
+
+  /**
+   * Segments a line within one cell needs to keep within RAPIDIA_LEVELED_SEGMENT_TOLERANCE
+   * of the cell's surface. A line spanning du, dv of the cell strays from it by
+   * deviation * |du * dv| at most, and n segments each stray by 1/n^2 of that.
+   */
+  uint16_t bilinear_cell_segments(const xy_pos_t &from, const xy_pos_t &to) {
+    const xy_pos_t mid = (from + to) * 0.5f - bilinear_start.asFloat();
+    const uint8_t gx = constrain(int16_t(mid.x * ABL_BG_FACTOR(x)), 0, ABL_BG_POINTS_X - 2),
+                  gy = constrain(int16_t(mid.y * ABL_BG_FACTOR(y)), 0, ABL_BG_POINTS_Y - 2);
+    const float stray = bilinear_cell_deviation[gx][gy] * ABS((to.x - from.x) * (to.y - from.y)) * ABL_BG_FACTOR(x) * ABL_BG_FACTOR(y);
+    if (stray <= RAPIDIA_LEVELED_SEGMENT_TOLERANCE) return 1;
+    return _MIN(CEIL(SQRT(stray * (1.0f / (RAPIDIA_LEVELED_SEGMENT_TOLERANCE)))), 1000);  // (whatever the grid holds)
+  }
+
+#endif
+
 // Get the Z adjustment for non-linear bed leveling
-float bilinear_z_offset(const xy_pos_t &raw) {
+// (With RAPIDIA_ABL_PLANE_TABLE, for grids out of the table's range.)
+float TERN(RAPIDIA_ABL_PLANE_TABLE, bilinear_z_offset_float, bilinear_z_offset)(const xy_pos_t &raw) {
 
   static float z1, d2, z3, d4, L, D;
 
@@ -344,11 +445,31 @@ float bilinear_z_offset(const xy_pos_t &raw) {
 
   #define CELL_INDEX(A,V) ((V - bilinear_start.A) * ABL_BG_FACTOR(A))
 
+  #if ENABLED(RAPIDIA_ABL_PLANE_TABLE)
+
+    static feedRate_t walk_fr_mm_s;
+
+    static void line_to_walked_segment(const xyze_pos_t &to) {
+      current_position = to;
+      line_to_current_position(walk_fr_mm_s);
+    }
+
+    /**
+     * Prepare a bilinear-leveled linear move on Cartesian,
+     * splitting the move where it crosses grid borders.
+     */
+    void bilinear_line_to_destination(const feedRate_t &scaled_fr_mm_s) {
+      walk_fr_mm_s = scaled_fr_mm_s;
+      bilinear_cell_walk(current_position, destination, line_to_walked_segment);
+    }
+
+  #else
+
   /**
    * Prepare a bilinear-leveled linear move on Cartesian,
    * splitting the move where it crosses grid borders.
    */
-  void bilinear_line_to_destination(const feedRate_t scaled_fr_mm_s, uint16_t x_splits, uint16_t y_splits) {
+  void bilinear_line_to_destination(const feedRate_t &scaled_fr_mm_s, uint16_t x_splits, uint16_t y_splits) {
     // Get current and destination cells for this line
     xy_int_t c1 { CELL_INDEX(x, current_position.x), CELL_INDEX(y, current_position.y) },
              c2 { CELL_INDEX(x, destination.x), CELL_INDEX(y, destination.y) };
@@ -408,6 +529,60 @@ float bilinear_z_offset(const xy_pos_t &raw) {
     bilinear_line_to_destination(scaled_fr_mm_s, x_splits, y_splits);
   }
 
+  #endif // !RAPIDIA_ABL_PLANE_TABLE
+
 #endif // IS_CARTESIAN && !SEGMENT_LEVELED_MOVES
 
+#if ENABLED(RAPIDIA_ABL_PLANE_TABLE)
+
+  /**
+   * Walk a line through the grid cells it crosses, passing segment() the end of
+   * each piece in order: each grid line crossing, then the end of the line.
+   */
+  void bilinear_cell_walk(const xyze_pos_t &start_pos, const xyze_pos_t &end_pos, void (*segment)(const xyze_pos_t &to)) {
+    // (segment() may move either.)
+    const xyze_pos_t start = start_pos, end = end_pos;
+
+    // Cells of the line's ends, and the grid lines crossed between them on each axis
+    xy_int_t c1 { int16_t((start.x - bilinear_start.x) * ABL_BG_FACTOR(x)), int16_t((start.y - bilinear_start.y) * ABL_BG_FACTOR(y)) },
+             c2 { int16_t((end.x - bilinear_start.x) * ABL_BG_FACTOR(x)), int16_t((end.y - bilinear_start.y) * ABL_BG_FACTOR(y)) };
+    LIMIT(c1.x, 0, ABL_BG_POINTS_X - 2);
+    LIMIT(c1.y, 0, ABL_BG_POINTS_Y - 2);
+    LIMIT(c2.x, 0, ABL_BG_POINTS_X - 2);
+    LIMIT(c2.y, 0, ABL_BG_POINTS_Y - 2);
+
+    xy_uint8_t crossings { uint8_t(ABS(c2.x - c1.x)), uint8_t(ABS(c2.y - c1.y)) };
+    const xy_int8_t dir { int8_t(c2.x < c1.x ? -1 : 1), int8_t(c2.y < c1.y ? -1 : 1) };
+    xy_int8_t grid_line { int8_t(c1.x + (dir.x > 0)), int8_t(c1.y + (dir.y > 0)) };  // The next to cross
+
+    const xyze_float_t delta = end - start;
+    const xy_float_t inv { crossings.x ? 1.0f / delta.x : 0, crossings.y ? 1.0f / delta.y : 0 };
+
+    while (crossings.x || crossings.y) {
+      // Where the line is at the next X and Y grid lines
+      const xy_pos_t line_pos { bilinear_start.x + ABL_BG_SPACING(x) * grid_line.x, bilinear_start.y + ABL_BG_SPACING(y) * grid_line.y };
+      const float tx = crossings.x ? (line_pos.x - start.x) * inv.x : 2,
+                  ty = crossings.y ? (line_pos.y - start.y) * inv.y : 2,
+                  t = _MIN(tx, ty);
+
+      xyze_pos_t split = start + delta * t;
+      // Whichever is crossed first (or both, at a corner) is split exactly on the grid line
+      if (tx <= ty) {
+        split.x = line_pos.x;
+        grid_line.x += dir.x;
+        crossings.x--;
+      }
+      if (ty <= tx) {
+        split.y = line_pos.y;
+        grid_line.y += dir.y;
+        crossings.y--;
+      }
+      segment(split);
+    }
+
+    segment(end);
+  }
+
+#endif // RAPIDIA_ABL_PLANE_TABLE
+
 #endif // AUTO_BED_LEVELING_BILINEAR
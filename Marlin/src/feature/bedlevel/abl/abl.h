@@ -27,6 +27,13 @@ extern xy_pos_t bilinear_grid_spacing, bilinear_start;
 extern xy_float_t bilinear_grid_factor;
 extern bed_mesh_t z_values;
 float bilinear_z_offset(const xy_pos_t &raw);
+#if ENABLED(RAPIDIA_ABL_PLANE_TABLE)
+  float bilinear_z_offset_float(const xy_pos_t &raw);
+  void bilinear_cell_walk(const xyze_pos_t &start, const xyze_pos_t &end, void (*segment)(const xyze_pos_t &to));
+#endif
+#if ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+  uint16_t bilinear_cell_segments(const xy_pos_t &from, const xy_pos_t &to);
+#endif
 
 void extrapolate_unprobed_bed_level();
 void print_bilinear_leveling_grid();
@@ -37,7 +44,11 @@ void refresh_bed_level();
 #endif
 
 #if IS_CARTESIAN && DISABLED(SEGMENT_LEVELED_MOVES)
-  void bilinear_line_to_destination(const feedRate_t &scaled_fr_mm_s, uint16_t x_splits=0xFFFF, uint16_t y_splits=0xFFFF);
+  #if ENABLED(RAPIDIA_ABL_PLANE_TABLE)
+    void bilinear_line_to_destination(const feedRate_t &scaled_fr_mm_s);
+  #else
+    void bilinear_line_to_destination(const feedRate_t &scaled_fr_mm_s, uint16_t x_splits=0xFFFF, uint16_t y_splits=0xFFFF);
+  #endif
 #endif
 
 #define _GET_MESH_X(I) float(bilinear_start.x + (I) * bilinear_grid_spacing.x)
@@ -70,7 +70,7 @@ void set_bed_leveling_enabled(const bool enable/*=true*/) {
     #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
       // Force bilinear_z_offset to re-calculate next time
       const xyz_pos_t reset { -9999.999, -9999.999, 0 };
-      (void)bilinear_z_offset(reset);
+      (void)TERN(RAPIDIA_ABL_PLANE_TABLE, bilinear_z_offset_float, bilinear_z_offset)(reset);
     #endif
 
     if (planner.leveling_active) {      // leveling from on to off
@@ -0,0 +1,357 @@
+#include "binary_motion.h"
+
+#if ENABLED(RAPIDIA_BINARY_MOTION)
+
+#include "checksum.h"
+#include "serial_line.h"
+
+#include "../../MarlinCore.h"
+#include "../../module/motion.h"
+#include "../../module/planner.h"
+
+namespace Rapidia
+{
+BinaryMotion binary_motion; // singleton
+
+// (a stalled frame is dropped and requested again.)
+static constexpr millis_t frame_timeout_ms = 500;
+
+BinaryMotion::state_t BinaryMotion::state = STATE_INACTIVE;
+int8_t BinaryMotion::port = 0;
+uint8_t BinaryMotion::sync = 0;
+uint8_t BinaryMotion::received = 0;
+bool BinaryMotion::escaped = false;
+uint16_t BinaryMotion::crc = 0;
+uint8_t BinaryMotion::crc_bytes[2];
+millis_t BinaryMotion::timeout = 0;
+
+BinaryMotion::Frame BinaryMotion::frames[2];
+uint8_t BinaryMotion::frame_r = 0;
+uint8_t BinaryMotion::frame_count = 0;
+uint8_t BinaryMotion::offset = 0;
+
+bool BinaryMotion::resync = true;
+int32_t BinaryMotion::target[XYZE];
+long BinaryMotion::line = -1;
+uint32_t BinaryMotion::moves = 0;
+
+static inline int read_port(const int8_t index)
+{
+  switch (index)
+  {
+    case 0: return MYSERIAL0.read();
+    #if HAS_MULTI_SERIAL
+      case 1: return MYSERIAL1.read();
+    #endif
+    default: return -1;
+  }
+}
+
+static inline uint16_t read_u16(const uint8_t* p)
+{
+  return p[0] | (uint16_t(p[1]) << 8);
+}
+
+static inline int32_t read_s32(const uint8_t* p)
+{
+  return int32_t(p[0] | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24));
+}
+
+// size of a move record's fields after its flags byte, or 0 if the flags are invalid.
+static uint8_t record_size(const uint8_t flags)
+{
+  if (flags & 0x80) return 0;
+  const uint8_t axis_size = (flags & BINARY_MOVE_WIDE) ? 4 : 2;
+  uint8_t size = 0;
+  if (flags & BINARY_MOVE_N) size += 4;
+  if (flags & BINARY_MOVE_F) size += 2;
+  LOOP_XYZE(i) if (TEST(flags, i)) size += axis_size;
+  return size + 1;
+}
+
+void BinaryMotion::start(const int8_t p)
+{
+  port = p;
+  sync = 0;
+  frame_r = frame_count = offset = 0;
+  escaped = false;
+  resync = true;
+  line = -1;
+  moves = 0;
+  state = STATE_START;
+}
+
+bool BinaryMotion::valid(const Frame& frame)
+{
+  if (frame.type == BINARY_MOTION_FRAME_END) return frame.len == 1;
+
+  // at least one record, and records exactly fill the payload.
+  if (frame.len < 2) return false;
+  for (uint8_t o = 1; o < frame.len;)
+  {
+    const uint8_t size = record_size(frame.data[o]);
+    if (!size) return false;
+    o += size;
+    if (o > frame.len) return false;
+  }
+  return true;
+}
+
+void BinaryMotion::reply(const bool ok, PGM_P err)
+{
+  PORT_REDIRECT(port);
+  SerialLine out;
+  LINE_ECHOPGM(out, "bm:{");
+  if (ok)
+  {
+    // (a repeated frame is acknowledged with its own seq.)
+    out.echo_key_P(PSTR("ok"));
+    out.echo_dec(frames[(frame_r + frame_count) & 1].data[0]);
+  }
+  else
+  {
+    // the seq to resend from.
+    out.echo_key_P(PSTR("rs"));
+    out.echo_dec(sync);
+    LINE_ECHOPGM(out, ",\"err\":\"");
+    out.echo_P(err);
+    out.echo_char('"');
+  }
+  out.echo_char('}');
+  out.eol();
+}
+
+void BinaryMotion::receive()
+{
+  if (state != STATE_START && state != STATE_CLOSING && ELAPSED(millis(), timeout))
+  {
+    reply(false, PSTR("timeout"));
+    state = STATE_START;
+  }
+
+  // (both buffers full: leave the bytes in the serial buffer.)
+  while (state != STATE_CLOSING && frame_count < COUNT(frames))
+  {
+    const int c = read_port(port);
+    if (c < 0) return;
+    uint8_t b = c;
+    timeout = millis() + frame_timeout_ms;
+
+    if (escaped)
+    {
+      b ^= BINARY_MOTION_ESCAPE_XOR;
+      escaped = false;
+    }
+    else if (b == BINARY_MOTION_ESCAPE)
+    {
+      escaped = true;
+      continue;
+    }
+
+    Frame& frame = frames[(frame_r + frame_count) & 1];
+    switch (state)
+    {
+      case STATE_START:
+        if (b != BINARY_MOTION_FRAME_START) continue;
+        crc = 0;
+        state = STATE_TYPE;
+        break;
+
+      case STATE_TYPE:
+        // (not a frame, or a frame lost its start; wait for the next STX.)
+        if (b != BINARY_MOTION_FRAME_MOVES && b != BINARY_MOTION_FRAME_END)
+        {
+          state = STATE_START;
+          continue;
+        }
+        frame.type = b;
+        state = STATE_LENGTH;
+        break;
+
+      case STATE_LENGTH:
+        if (!b || b > sizeof(frame.data))
+        {
+          reply(false, PSTR("length"));
+          state = STATE_START;
+          continue;
+        }
+        frame.len = b;
+        received = 0;
+        state = STATE_PAYLOAD;
+        break;
+
+      case STATE_PAYLOAD:
+        frame.data[received++] = b;
+        if (received == frame.len)
+        {
+          received = 0;
+          state = STATE_CRC;
+        }
+        break;
+
+      case STATE_CRC:
+        crc_bytes[received++] = b;
+        if (received < 2) continue;
+
+        state = STATE_START;
+        if (read_u16(crc_bytes) != crc)
+        {
+          reply(false, PSTR("crc"));
+          continue;
+        }
+
+        if (frame.data[0] == uint8_t(sync - 1))
+        {
+          // the host missed our acknowledgement.
+          reply(true);
+          continue;
+        }
+
+        if (frame.data[0] != sync)
+        {
+          reply(false, PSTR("seq"));
+          continue;
+        }
+
+        if (!valid(frame))
+        {
+          reply(false, PSTR("format"));
+          continue;
+        }
+
+        reply(true);
+        sync++;
+        frame_count++;
+        if (frame.type == BINARY_MOTION_FRAME_END) state = STATE_CLOSING;
+        continue;
+
+      default: return;
+    }
+
+    // (everything from STX through the payload.)
+    checksum(crc, &b, 1, CHECKSUMS_CRC16);
+  }
+}
+
+bool BinaryMotion::advance()
+{
+  if (!frame_count) return false;
+
+  Frame& frame = frames[frame_r];
+  if (frame.type == BINARY_MOTION_FRAME_END)
+  {
+    frame_count--;
+    finish();
+    return true;
+  }
+
+  // decode the record (after the seq byte.)
+  if (!offset) offset = 1;
+  const uint8_t* p = frame.data + offset;
+  const uint8_t flags = *p++;
+
+  if (flags & BINARY_MOVE_N)
+  {
+    line = read_s32(p);
+    p += 4;
+  }
+  else
+    line++;
+
+  feedRate_t fr_mm_s = 0;
+  if (flags & BINARY_MOVE_F)
+  {
+    fr_mm_s = MMM_TO_MMS(read_u16(p));
+    p += 2;
+  }
+
+  int32_t delta[XYZE] = { 0 };
+  LOOP_XYZE(i) if (TEST(flags, i))
+  {
+    if (flags & BINARY_MOVE_WIDE)
+    {
+      delta[i] = read_s32(p);
+      p += 4;
+    }
+    else
+    {
+      delta[i] = int16_t(read_u16(p));
+      p += 2;
+    }
+  }
+
+  // release the frame as soon as possible, so the next can be received while this move is planned.
+  offset = p - frame.data;
+  if (offset >= frame.len)
+  {
+    offset = 0;
+    frame_r ^= 1;
+    frame_count--;
+  }
+
+  // the target is kept in fixed point, so rounding doesn't accumulate over many small moves.
+  if (resync)
+  {
+    LOOP_XYZE(i) target[i] = LROUND(current_position[i] * BINARY_MOTION_FIXED_POINT);
+    resync = false;
+  }
+  LOOP_XYZE(i) target[i] += delta[i];
+
+  if (fr_mm_s) feedrate_mm_s = fr_mm_s;
+
+  if (IsRunning())
+  {
+    LOOP_XYZE(i) destination[i] = target[i] * (1.0f / BINARY_MOTION_FIXED_POINT);
+    prepare_line_to_destination();
+    TERN_(RAPIDIA_BLOCK_SOURCE, planner.mark_block(line));
+    moves++;
+  }
+  return true;
+}
+
+void BinaryMotion::clear()
+{
+  if (!active()) return;
+
+  // (nothing more will be received after an end frame.)
+  if (state == STATE_CLOSING)
+  {
+    finish();
+    return;
+  }
+
+  // (a frame being received is dropped, and requested again.)
+  if (state != STATE_START) reply(false, PSTR("pause"));
+  state = STATE_START;
+  escaped = false;
+  frame_count = 0;
+  offset = 0;
+  resync = true;
+}
+
+long BinaryMotion::first_line()
+{
+  if (!frame_count) return -1;
+  const Frame& frame = frames[frame_r];
+  if (frame.type != BINARY_MOTION_FRAME_MOVES) return -1;
+  const uint8_t* p = frame.data + (offset ? offset : 1);
+  return (*p & BINARY_MOVE_N) ? read_s32(p + 1) : line + 1;
+}
+
+void BinaryMotion::finish()
+{
+  state = STATE_INACTIVE;
+  frame_count = 0;
+  offset = 0;
+
+  PORT_REDIRECT(port);
+  SerialLine out;
+  LINE_ECHOPGM(out, "bm:{");
+  LINE_ECHO_KEY_STR(out, "end");
+  out.echo_dec(moves);
+  out.echo_char('}');
+  out.eol();
+}
+}
+
+#endif
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(RAPIDIA_BINARY_MOTION)
+
+namespace Rapidia
+{
+
+// binary motion frame (multi-byte values are little-endian):
+//   STX <type:u8> <len:u8> <seq:u8> <payload...> <crc16:u16>
+// len counts the bytes from seq to the end of the payload (inclusive);
+// crc16 (XMODEM) covers everything from STX to the end of the payload.
+// (the same framing as binary heartbeats.)
+//
+// on the wire, LF, CR, EOT and DLE bytes are sent as DLE followed by the byte ^ 0x20, so the
+// emergency parser (which still reads the serial stream) never sees a line end or an EOT
+// inside a frame. lengths and crc16 are of the unescaped bytes.
+constexpr uint8_t BINARY_MOTION_FRAME_START = 0x02; // STX
+constexpr uint8_t BINARY_MOTION_ESCAPE      = 0x10; // DLE
+constexpr uint8_t BINARY_MOTION_ESCAPE_XOR  = 0x20;
+constexpr uint8_t BINARY_MOTION_FRAME_MOVES = 'M';  // payload is move records
+constexpr uint8_t BINARY_MOTION_FRAME_END   = 'E';  // return to text gcode (no payload)
+
+// move record: <flags:u8> [N:s32] [F:u16] [X] [Y] [Z] [E]
+// X/Y/Z/E are deltas from the previous move's target, in 1/BINARY_MOTION_FIXED_POINT mm,
+// s16 (or s32 with BINARY_MOVE_WIDE). N is the source line (otherwise the previous line + 1).
+// F is the feedrate in mm/min (otherwise unchanged).
+enum BinaryMoveFlag : uint8_t
+{
+  BINARY_MOVE_X    = _BV(0),
+  BINARY_MOVE_Y    = _BV(1),
+  BINARY_MOVE_Z    = _BV(2),
+  BINARY_MOVE_E    = _BV(3),
+  BINARY_MOVE_F    = _BV(4),
+  BINARY_MOVE_N    = _BV(5),
+  BINARY_MOVE_WIDE = _BV(6)
+};
+
+constexpr int32_t BINARY_MOTION_FIXED_POINT = 1000;
+
+// receives binary motion frames in place of text gcode (R760), and feeds the
+// moves they contain to the planner as if they were G1 commands.
+//
+// frames are received from idle() into one of two buffers, and acknowledged
+// with a single bm:{"ok":seq} line per frame. moves are planned from the main
+// loop, one per pass, once the gcode queue is empty.
+class BinaryMotion
+{
+public:
+  // switches the given serial port to binary motion frames.
+  static void start(const int8_t port);
+
+  static bool active() { return state != STATE_INACTIVE; }
+
+  // reads frame bytes from the serial port (called instead of reading gcode lines.)
+  static void receive();
+
+  // plans the next buffered move. returns false if there was none.
+  // (may block waiting for room in the planner, like G1.)
+  static bool advance();
+
+  // discards buffered moves (e.g. on pause.) the next move is planned relative to the current position.
+  static void clear();
+
+  // source line of the next buffered move, or -1.
+  static long first_line();
+
+private:
+  enum state_t : uint8_t
+  {
+    STATE_INACTIVE,
+    STATE_START,    // waiting for STX
+    STATE_TYPE,
+    STATE_LENGTH,
+    STATE_PAYLOAD,  // seq, then payload
+    STATE_CRC,
+    STATE_CLOSING   // end frame received; no more bytes are read
+  };
+
+  struct Frame
+  {
+    uint8_t type;
+    uint8_t len;    // bytes in data (seq + payload)
+    uint8_t data[1 + RAPIDIA_BINARY_MOTION_FRAME_SIZE];
+  };
+
+  static bool valid(const Frame&);
+  static void reply(const bool ok, PGM_P err=nullptr);
+  static void finish();
+
+  static state_t state;
+  static int8_t port;
+  static uint8_t sync;          // expected seq of the next frame
+  static uint8_t received;      // bytes received of the current frame section
+  static bool escaped;          // the last byte was DLE
+  static uint16_t crc;
+  static uint8_t crc_bytes[2];
+  static millis_t timeout;
+
+  static Frame frames[2];
+  static uint8_t frame_r;       // frame being planned
+  static uint8_t frame_count;   // frames received and not yet planned
+  static uint8_t offset;        // read offset in frames[frame_r].data
+
+  static bool resync;           // target must be re-read from current_position
+  static int32_t target[XYZE];  // last move's target, in fixed point
+  static long line;             // last move's source line
+  static uint32_t moves;        // moves planned since start()
+};
+
+extern BinaryMotion binary_motion;
+}
+
+#endif
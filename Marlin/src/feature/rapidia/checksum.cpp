@@ -10,9 +10,6 @@ namespace Rapidia
     checksum_mode_t checksum_mode_out { CHECKSUMS_DISABLED };
     checksum_mode_t checksum_mode_in  { CHECKSUMS_XOR_OPTIONAL };
 
-    // contains a string of the form "*XXXX" for the checksum; can be printed.
-    static char checksum_string[7] = {'*'};
-
     uint8_t& checksum8(checksum_t& checksum)
     {
         return *reinterpret_cast<uint8_t*>(&checksum);
@@ -39,21 +36,37 @@ namespace Rapidia
 
     void checksum_pgm(checksum_t& c, const void* data, size_t length, checksum_mode_t checksum_mode)
     {
-        while (length --> 0)
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        switch (checksum_mode)
         {
-            uint8_t v = pgm_read_byte((static_cast<const uint8_t*>(data) + length));
-            checksum(c, &v, 1, checksum_mode);
+        case CHECKSUMS_DISABLED:
+            return;
+        case CHECKSUMS_XOR:
+        case CHECKSUMS_XOR_OPTIONAL:
+            while (length --> 0)
+            {
+                checksum8(c) ^= pgm_read_byte(p++);
+            }
+            return;
+        case CHECKSUMS_CRC16:
+            // (crc is order-dependent, so this must run front to back.)
+            while (length --> 0)
+            {
+                const uint8_t v = pgm_read_byte(p++);
+                crc16(&c, &v, 1);
+            }
+            return;
         }
     }
 
-    void checksum_eol(checksum_t& c, checksum_mode_t checksum_mode)
+    uint8_t checksum_suffix(char* out, checksum_t c, checksum_mode_t checksum_mode)
     {
         if (checksum_mode == CHECKSUMS_DISABLED)
         {
-            SERIAL_EOL();
-            return;
+            out[0] = 0;
+            return 0;
         }
-        
+
         // the value to print
         uint32_t v = (checksum_mode == CHECKSUMS_XOR || checksum_mode == CHECKSUMS_XOR_OPTIONAL)
             ? checksum8(c)
@@ -63,15 +76,46 @@ namespace Rapidia
         int radix = (checksum_mode == CHECKSUMS_CRC16)
             ? 16
             : 10;
-            
+
         // place string after '*' character.
-        itoa(v, checksum_string + 1, radix);
+        out[0] = '*';
+        itoa(v, out + 1, radix);
+        return strlen(out);
+    }
+
+    void checksum_eol(checksum_t& c, checksum_mode_t checksum_mode)
+    {
+        // contains a string of the form "*XXXX" for the checksum; can be printed.
+        char checksum_string[7];
+        checksum_suffix(checksum_string, c, checksum_mode);
         SERIAL_ECHOLN(checksum_string);
 
         // reset checksum for next line.
         c = 0;
     }
 
+    void echo_checksum_name(checksum_mode_t checksum_mode)
+    {
+        switch (checksum_mode)
+        {
+        case CHECKSUMS_DISABLED:
+            SERIAL_ECHOPGM("disabled");
+            return;
+        case CHECKSUMS_XOR:
+            SERIAL_ECHOPGM("xor");
+            return;
+        case CHECKSUMS_XOR_OPTIONAL:
+            SERIAL_ECHOPGM("xor (optional)");
+            return;
+        case CHECKSUMS_CRC16:
+            SERIAL_ECHOPGM("crc16/XMODEM");
+            return;
+        default:
+            SERIAL_ECHOPGM("unknown");
+            return;
+        }
+    }
+
     bool compare_checksum(checksum_t c, const char* cmp, checksum_mode_t checksum_mode)
     {
         switch (checksum_mode)
@@ -21,9 +21,16 @@ typedef uint16_t checksum_t;
 void checksum(checksum_t& checksum, const void* data, size_t length, checksum_mode_t=checksum_mode_out);
 void checksum_pgm(checksum_t& checksum, const void* data, size_t length, checksum_mode_t=checksum_mode_out);
 
+// writes "*XXXX" (null-terminated) to out, or "" if checksums are disabled.
+// out must hold at least 7 chars. returns the length written.
+uint8_t checksum_suffix(char* out, checksum_t checksum, checksum_mode_t=checksum_mode_out);
+
 // echoes "*XXXX\n" then resets checksum to 0.
 void checksum_eol(checksum_t& checksum, checksum_mode_t=checksum_mode_out);
 
+// echoes the name of the checksum mode.
+void echo_checksum_name(checksum_mode_t);
+
 // compares checksum against the given string
 // returns true on error.
 bool compare_checksum(checksum_t checksum, const char* compare, checksum_mode_t);
@@ -43,9 +50,9 @@ inline bool checksum_required(checksum_mode_t c)
 
 #define SERIAL_INIT_CHECKSUM() Rapidia::checksum_t __crc__ = 0
 #define _SERIAL_FN_CHECKSUM_(str) \
-    do { const char* _s = str; Rapidia::checksum(__crc__, _s, strlen(_s)); SERIAL_OUT(print, _s); } while (0)
+    do { const char* _s = str; const size_t _l = strlen(_s); Rapidia::checksum(__crc__, _s, _l); SERIAL_OUT(print, _s); } while (0)
 #define _SERIAL_FN_PGM_CHECKSUM_(str) \
-    do { const char* _s = PSTR(str); Rapidia::checksum_pgm(__crc__, _s, strlen(_s)); serialprintPGM(_s); } while (0)
+    do { const char* _s = PSTR(str); const size_t _l = strlen_P(_s); Rapidia::checksum_pgm(__crc__, _s, _l); serialprintPGM(_s); } while (0)
 #define SERIAL_ECHO_START_CHK() SERIAL_ECHOPGM_CHK("echo:")
 #define SERIAL_ECHO_CHK(str) _SERIAL_FN_CHECKSUM_(str)
 #define SERIAL_ECHOPGM_CHK(str) _SERIAL_FN_PGM_CHECKSUM_(str)
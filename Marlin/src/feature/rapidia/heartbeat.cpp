@@ -1,7 +1,9 @@
 #include "heartbeat.h"
 
 #include "checksum.h"
+#include "serial_line.h"
 #include "mileage.h"
+#include "task_profiler.h"
 
 #include "../../inc/MarlinConfig.h"
 #include "../../module/stepper.h"
@@ -9,6 +11,7 @@
 #include "../../module/endstops.h"
 #include "../../module/motion.h"
 #include "../../gcode/gcode.h"
+#include "../../libs/crc16.h"
 
 #if ENABLED(RAPIDIA_HEARTBEAT)
 
@@ -16,21 +19,31 @@ namespace Rapidia
 {
 static uint16_t heartbeat_interval_ms = 0;
 static const uint16_t min_heartbeat_interval_ms = 80;
+static const uint16_t min_delta_heartbeat_interval_ms = 20;
 static millis_t next_heartbeat_report_ms = 0;
 Heartbeat heartbeat; // singleton
 
 HeartbeatSelectionUint Heartbeat::selection
   = static_cast<HeartbeatSelectionUint>(HeartbeatSelection::_DEFAULT);
+HeartbeatEncoding Heartbeat::encoding = HeartbeatEncoding::TEXT;
+uint16_t Heartbeat::last_frame_bytes = 0;
+
+static uint16_t keyframe_interval_ms = 0;
 
 void Heartbeat::set_interval(uint16_t v)
 {
-  if (v && v < min_heartbeat_interval_ms)
+  // delta heartbeats are small enough to be sent more frequently.
+  const uint16_t min_interval_ms = keyframe_interval_ms
+    ? min_delta_heartbeat_interval_ms
+    : min_heartbeat_interval_ms;
+
+  if (v && v < min_interval_ms)
   {
-    v = min_heartbeat_interval_ms;
+    v = min_interval_ms;
 
     SERIAL_ECHO_START();
     SERIAL_ECHOPGM("Heartbeat interval is lower than minimum ");
-    SERIAL_ECHO(min_heartbeat_interval_ms);
+    SERIAL_ECHO(min_interval_ms);
     SERIAL_ECHOLNPGM(" ms. Using minimum instead.");
   }
 
@@ -38,42 +51,40 @@ void Heartbeat::set_interval(uint16_t v)
   next_heartbeat_report_ms = millis() + v;
 }
 
-static void report_homed(CHK_ARGDEF)
+static void report_homed(SerialLine& line)
 {
   const bool x_homed = axis_homed & _BV(X_AXIS);
   const bool y_homed = axis_homed & _BV(Y_AXIS);
   const bool z_homed = axis_homed & _BV(Z_AXIS);
-  if (x_homed) SERIAL_CHAR_CHK('x');
-  if (y_homed) SERIAL_CHAR_CHK('y');
-  if (z_homed) SERIAL_CHAR_CHK('z');
-  if (homing_semaphore) SERIAL_CHAR_CHK('h');
+  if (x_homed) line.echo_char('x');
+  if (y_homed) line.echo_char('y');
+  if (z_homed) line.echo_char('z');
+  if (homing_semaphore) line.echo_char('h');
 }
 
-static void report_xyzetf(CHK_ARGSDEF const xyze_pos_t &pos, const uint8_t extruder, const bool feedrate=false, const uint8_t n=XYZE, const uint8_t precision=3) {
-  char str[12];
-
+static void report_xyzetf(SerialLine& line, const xyze_pos_t &pos, const uint8_t extruder, const bool feedrate=false, const uint8_t n=XYZE, const uint8_t precision=3) {
   // position.
   LOOP_L_N(a, n) {
-    ECHO_KEY_CHK(axis_codes[a]);
-    SERIAL_ECHO_CHK(dtostrf(pos[a], 1, precision, str));
-    SERIAL_CHAR_CHK(',');
+    line.echo_key(axis_codes[a]);
+    line.echo_float(pos[a], precision);
+    line.echo_char(',');
   }
 
   if (feedrate)
   {
-    ECHO_KEY_CHK('F');
-    SERIAL_ECHO_CHK(dtostrf(feedrate_mm_s, 1, precision, str));
-    SERIAL_CHAR_CHK(',');
+    line.echo_key('F');
+    line.echo_float(feedrate_mm_s, precision);
+    line.echo_char(',');
   }
 
   // extruder number
-  ECHO_KEY_CHK('T');
-  SERIAL_CHAR_CHK('0' + extruder);
+  line.echo_key('T');
+  line.echo_char('0' + extruder);
 }
 
 #define TEST_FLAG(a, b) (!!((uint32_t)(a) & (uint32_t)(b)))
 
-void Heartbeat::serial_info(HeartbeatSelection selection, bool bare)
+void Heartbeat::serial_info(HeartbeatSelection selection, bool bare, bool delta)
 {
   #if ENABLED(RAPIDIA_MILEAGE)
     const MileageData* mileage_data;
@@ -83,14 +94,12 @@ void Heartbeat::serial_info(HeartbeatSelection selection, bool bare)
     }
   #endif
 
-  static char chbuff[32];
-
-  SERIAL_INIT_CHECKSUM();
+  SerialLine line;
 
   // begin heartbeat
   if (!bare)
   {
-    SERIAL_ECHO_CHK("H:{");
+    line.echo(delta ? "HD:{" : "H:{");
   }
 
   // separator accumulator
@@ -99,26 +108,26 @@ void Heartbeat::serial_info(HeartbeatSelection selection, bool bare)
   // plan position
   if (TEST_FLAG(selection, HeartbeatSelection::PLAN_POSITION))
   {
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_CHK('P');
-    SERIAL_CHAR_CHK('{');
-
-    report_xyzetf(CHK_ARGS current_position.asLogical(), active_extruder, TEST_FLAG(selection, HeartbeatSelection::FEEDRATE));
-    SERIAL_CHAR_CHK('}');
-
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_CHK('H');
-    SERIAL_CHAR_CHK('"');
-    report_homed(CHK_ARG);
-    SERIAL_CHAR_CHK('"');
+    line.echo_separator(sep);
+    line.echo_key('P');
+    line.echo_char('{');
+
+    report_xyzetf(line, current_position.asLogical(), active_extruder, TEST_FLAG(selection, HeartbeatSelection::FEEDRATE));
+    line.echo_char('}');
+
+    line.echo_separator(sep);
+    line.echo_key('H');
+    line.echo_char('"');
+    report_homed(line);
+    line.echo_char('"');
   }
 
   // actual position
   if (TEST_FLAG(selection, HeartbeatSelection::ABS_POSITION))
   {
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_CHK('C');
-    SERIAL_CHAR_CHK('{');
+    line.echo_separator(sep);
+    line.echo_key('C');
+    line.echo_char('{');
 
     // unit conversion steps -> logical
     Stepper::State state = stepper.report_state();
@@ -128,68 +137,67 @@ void Heartbeat::serial_info(HeartbeatSelection selection, bool bare)
       position[axis] = state.position[axis] / planner.settings.axis_steps_per_mm[axis];
     }
 
-    report_xyzetf(CHK_ARGS position.asLogical(), state.extruder);
-    SERIAL_CHAR_CHK('}');
+    report_xyzetf(line, position.asLogical(), state.extruder);
+    line.echo_char('}');
   }
 
   // relative mode axes:
   if (TEST_FLAG(selection, HeartbeatSelection::RELMODE))
   {
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_CHK('R');
-    SERIAL_CHAR_CHK('"');
+    line.echo_separator(sep);
+    line.echo_key('R');
+    line.echo_char('"');
     LOOP_XYZE(axis)
     {
       if (gcode.axis_is_relative(AxisEnum(axis)))
       {
-        SERIAL_CHAR_CHK(axis_codes[axis]);
+        line.echo_char(axis_codes[axis]);
       }
     }
-    SERIAL_CHAR_CHK('"');
+    line.echo_char('"');
   }
 
   // dualx info
   if (TEST_FLAG(selection, HeartbeatSelection::DUALX))
   {
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_CHK('X');
-    SERIAL_CHAR_CHK('{');
+    line.echo_separator(sep);
+    line.echo_key('X');
+    line.echo_char('{');
     {
-      char str[12];
-
       // dual_x_carriage_mode
-      ECHO_KEY_CHK('S');
-      SERIAL_CHAR_CHK('0' + (int32_t)(dual_x_carriage_mode));
-      SERIAL_CHAR_CHK(',');
+      line.echo_key('S');
+      line.echo_char('0' + (int32_t)(dual_x_carriage_mode));
+      line.echo_char(',');
 
       // active toolhead
-      ECHO_KEY_CHK('T');
-      SERIAL_CHAR_CHK('0' + (int32_t)(active_extruder));
-      SERIAL_CHAR_CHK(',');
+      line.echo_key('T');
+      line.echo_char('0' + (int32_t)(active_extruder));
+      line.echo_char(',');
 
       // stored x position
-      ECHO_KEY_CHK('X');
-      SERIAL_ECHO_CHK(dtostrf(inactive_extruder_x_pos, 1, 3, str));
+      line.echo_key('X');
+      line.echo_float(inactive_extruder_x_pos, 3);
 
       // TODO: stored feedrate.
     }
-    SERIAL_CHAR_CHK('}');
+    line.echo_char('}');
   }
 
   if (TEST_FLAG(selection, HeartbeatSelection::MILEAGE))
     {
-      ECHO_SEPARATOR_CHK(sep);
-      ECHO_KEY_CHK('M');
+      line.echo_separator(sep);
+      line.echo_key('M');
       #if ENABLED(RAPIDIA_MILEAGE)
-      SERIAL_CHAR_CHK('{');
+      char chbuff[32];
+      line.echo_char('{');
       for (uint8_t e = 0; e < EXTRUDERS; ++e)
       {
-        SERIAL_CHAR_CHK('"');
-        SERIAL_CHAR_CHK('E');
-        SERIAL_CHAR_CHK(('1' + e));
+        line.echo_char('"');
+        line.echo_char('E');
+        line.echo_char(('1' + e));
         static_assert(EXTRUDERS < 9, "at most 9 extruders function for this arithmetic.");
-        SERIAL_CHAR_CHK('"');
-        SERIAL_CHAR_CHK(':');
+        line.echo_char('"');
+        line.echo_char(':');
 
         uint64_t val = mileage_to_u64nm(mileage_data->e_mm[e]);
         // convert to mm/1000
@@ -205,33 +213,33 @@ void Heartbeat::serial_info(HeartbeatSelection selection, bool bare)
           chbuff[i] = chbuff[i + 1];
         }
         chbuff[sizeof(chbuff) - 1 - PREC] = '.';
-        SERIAL_ECHO_CHK(c);
-        SERIAL_CHAR_CHK(',');
+        line.echo(c);
+        line.echo_char(',');
       }
-      ECHO_KEY_CHK('I');
-      SERIAL_ECHO_CHK(itoa(mileage.get_save_index(), chbuff, 10));
+      line.echo_key('I');
+      line.echo_dec(mileage.get_save_index());
       if (mileage.get_expended())
       {
-        SERIAL_CHAR_CHK(',');
-        SERIAL_ECHOPGM_CHK("\"expended\":true");
+        line.echo_char(',');
+        LINE_ECHOPGM(line, "\"expended\":true");
       }
-      SERIAL_CHAR_CHK('}');
+      line.echo_char('}');
       #else
-      SERIAL_ECHO_CHK("null");
+      line.echo("null");
       #endif
     }
 
   // endstops -- report endstops closed state (at this moment)
   if (TEST_FLAG(selection, HeartbeatSelection::ENDSTOPS))
   {
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_CHK('E');
-    SERIAL_CHAR_CHK('"');
+    line.echo_separator(sep);
+    line.echo_key('E');
+    line.echo_char('"');
 
     // read from the endstop pins directly.
     // (this info doesn't seem to be cached in the Endstops class.)
 
-    #define ES_REPORT(S, N) if (endstops.endstop_state(S)) SERIAL_CHAR_CHK(N);
+    #define ES_REPORT(S, N) if (endstops.endstop_state(S)) line.echo_char(N);
 
     ES_REPORT(X_MIN, 'x');
     ES_REPORT(Y_MIN, 'y');
@@ -240,82 +248,403 @@ void Heartbeat::serial_info(HeartbeatSelection selection, bool bare)
     ES_REPORT(Y_MAX, 'Y');
     ES_REPORT(Z_MAX, 'Z');
 
-    SERIAL_CHAR_CHK('"');
+    line.echo_char('"');
   }
 
   if (TEST_FLAG(selection, HeartbeatSelection::DEBUG))
   {
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("executing-command");
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "executing-command");
     if (GcodeSuite::dbg_current_command_letter)
     {
-      if (sprintf(chbuff, "\"%c%d\"", GcodeSuite::dbg_current_command_letter, GcodeSuite::dbg_current_codenum) > 0)
-      {
-        SERIAL_ECHO_CHK(chbuff);
-      }
-      else
-      {
-        SERIAL_ECHO_CHK("\"\"");
-      }
+      line.echo_char('"');
+      line.echo_char(GcodeSuite::dbg_current_command_letter);
+      line.echo_dec(GcodeSuite::dbg_current_codenum);
+      line.echo_char('"');
     }
     else
     {
-      SERIAL_ECHO_CHK("\"\"");
+      line.echo("\"\"");
     }
 
 
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("pause-nobuffer");
-    SERIAL_ECHO_CHK(itoa(planner.prevent_block_buffering, chbuff, 10));
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "pause-nobuffer");
+    line.echo_dec(planner.prevent_block_buffering);
 
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("pause-noextrude");
-    SERIAL_ECHO_CHK(itoa(planner.prevent_block_extrusion, chbuff, 10));
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "pause-noextrude");
+    line.echo_dec(planner.prevent_block_extrusion);
 
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("buffer-moves-planned");
-    SERIAL_ECHO_CHK(itoa(planner.movesplanned(), chbuff, 10));
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "buffer-moves-planned");
+    line.echo_dec(planner.movesplanned());
 
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("buffer-moves-nonbusy");
-    SERIAL_ECHO_CHK(itoa(planner.nonbusy_movesplanned(), chbuff, 10));
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "buffer-moves-nonbusy");
+    line.echo_dec(planner.nonbusy_movesplanned());
 
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("endstop-live-state");
-    SERIAL_ECHO_CHK(itoa(endstops.live_state, chbuff, 10));
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "endstop-live-state");
+    line.echo_dec(endstops.live_state);
 
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("endstop-state");
-    SERIAL_ECHO_CHK(itoa(endstops.state(), chbuff, 10));
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "endstop-state");
+    line.echo_dec(endstops.state());
 
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("endstop-enable");
-    SERIAL_ECHO_CHK(itoa(endstops.enabled, chbuff, 10));
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "endstop-enable");
+    line.echo_dec(endstops.enabled);
 
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("endstop-enable-globally");
-    SERIAL_ECHO_CHK(itoa(endstops.enabled_globally, chbuff, 10));
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "endstop-enable-globally");
+    line.echo_dec(endstops.enabled_globally);
 
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("endstop-hit-state");
-    SERIAL_ECHO_CHK(itoa(endstops.hit_state, chbuff, 10));
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "endstop-hit-state");
+    line.echo_dec(endstops.hit_state);
 
     #if ENABLED(RAPIDIA_NOZZLE_PLUG_HYSTERESIS)
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("zmax-hyst-count");
-    SERIAL_ECHO_CHK(itoa(endstops.z_max_hysteresis_count, chbuff, 10));
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "zmax-hyst-count");
+    line.echo_dec(endstops.z_max_hysteresis_count);
+
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "zmax-hyst-threshold");
+    line.echo_dec(endstops.z_max_hysteresis_threshold);
+    #endif
 
-    ECHO_SEPARATOR_CHK(sep);
-    ECHO_KEY_STR_CHK("zmax-hyst-threshold");
-    SERIAL_ECHO_CHK(itoa(endstops.z_max_hysteresis_threshold, chbuff, 10));
+    #if ENABLED(RAPIDIA_TASK_PROFILER)
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "serial-gap-max");
+    line.echo_dec(TaskProfiler::serial_gap_max_us());
+
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "idle-max");
+    line.echo_dec(TaskProfiler::idle_max_us());
     #endif
   }
 
   if (!bare)
   {
-    SERIAL_ECHOLNPGM_CHK("}");
+    line.echo_char('}');
+    line.eol();
+  }
+  else
+  {
+    line.send();
   }
   // end heartbeat
+
+  last_frame_bytes = line.bytes();
+}
+
+// field sizes for binary heartbeat frames.
+static constexpr uint8_t FRAME_HEADER_BYTES = 4; // STX, type, len, selection
+static constexpr uint8_t FRAME_PLAN_BYTES = XYZE * 4 + 4 + 1 + 1; // position, feedrate, tool, homed
+static constexpr uint8_t FRAME_ABS_BYTES = XYZE * 4 + 1; // position, tool
+static constexpr uint8_t FRAME_RELMODE_BYTES = 1;
+static constexpr uint8_t FRAME_DUALX_BYTES = 1 + 1 + 4; // mode, tool, stored x
+static constexpr uint8_t FRAME_ENDSTOPS_BYTES = 1;
+static constexpr uint8_t FRAME_DEBUG_BYTES = 1 + 2 + 1 + 1 + 1 + 2 + 2 + 1 + 1 + 1 + 1 + 4 + 4;
+static constexpr uint8_t FRAME_MILEAGE_BYTES = EXTRUDERS * 8 + 1 + 1; // nm per extruder, save index, flags
+
+// offset of each field (by selection bit) within the delta cache.
+// (FEEDRATE is encoded as part of PLAN_POSITION.)
+static constexpr uint8_t FRAME_FIELD_OFFSET[] = {
+  0,
+  FRAME_PLAN_BYTES,
+  FRAME_PLAN_BYTES + FRAME_ABS_BYTES,
+  FRAME_PLAN_BYTES + FRAME_ABS_BYTES + FRAME_RELMODE_BYTES,
+  FRAME_PLAN_BYTES + FRAME_ABS_BYTES + FRAME_RELMODE_BYTES,
+  FRAME_PLAN_BYTES + FRAME_ABS_BYTES + FRAME_RELMODE_BYTES + FRAME_DUALX_BYTES,
+  FRAME_PLAN_BYTES + FRAME_ABS_BYTES + FRAME_RELMODE_BYTES + FRAME_DUALX_BYTES + FRAME_ENDSTOPS_BYTES,
+  FRAME_PLAN_BYTES + FRAME_ABS_BYTES + FRAME_RELMODE_BYTES + FRAME_DUALX_BYTES + FRAME_ENDSTOPS_BYTES + FRAME_DEBUG_BYTES,
+};
+static constexpr uint8_t FRAME_FIELDS_BYTES = FRAME_FIELD_OFFSET[7] + FRAME_MILEAGE_BYTES;
+static constexpr uint8_t FRAME_MAX_BYTES = FRAME_HEADER_BYTES + FRAME_FIELDS_BYTES + sizeof(uint16_t);
+
+static_assert(FRAME_FIELDS_BYTES + 1 <= 0xff,
+  "binary heartbeat payload must fit in the u8 length prefix."
+);
+
+// accumulates a binary heartbeat frame (little-endian).
+class HeartbeatFrame
+{
+public:
+  uint8_t buff[FRAME_MAX_BYTES];
+  uint8_t len;
+
+  void put8(uint8_t v)   { buff[len++] = v; }
+  void put16(uint16_t v) { put8(v); put8(v >> 8); }
+  void put32(uint32_t v) { put16(v); put16(v >> 16); }
+  void put64(uint64_t v) { put32(v); put32(v >> 32); }
+
+  // mm -> fixed point
+  void put_fixed(float v) { put32(static_cast<int32_t>(LROUND(v * HEARTBEAT_FIXED_POINT))); }
+};
+
+static HeartbeatFrame frame;
+
+// delta mode state.
+// the cache holds the binary encoding of every field as it was last sent.
+static millis_t next_keyframe_ms = 0;
+static uint8_t field_cache[FRAME_FIELDS_BYTES];
+static HeartbeatSelectionUint cached_fields = 0;
+
+static void frame_xyzet(const xyze_pos_t &pos, const uint8_t extruder)
+{
+  LOOP_XYZE(a) frame.put_fixed(pos[a]);
+  frame.put8(extruder);
+}
+
+void Heartbeat::frame_field(const HeartbeatSelection field, const HeartbeatSelection selection)
+{
+  switch (field)
+  {
+  case HeartbeatSelection::PLAN_POSITION:
+    frame_xyzet(current_position.asLogical(), active_extruder);
+    frame.put_fixed(TEST_FLAG(selection, HeartbeatSelection::FEEDRATE) ? feedrate_mm_s : 0);
+    frame.put8(
+        (axis_homed & (_BV(X_AXIS) | _BV(Y_AXIS) | _BV(Z_AXIS)))
+      | (homing_semaphore ? _BV(3) : 0)
+    );
+    break;
+
+  case HeartbeatSelection::ABS_POSITION:
+    {
+      Stepper::State state = stepper.report_state();
+      xyze_pos_t position;
+      LOOP_XYZE(axis)
+      {
+        position[axis] = state.position[axis] / planner.settings.axis_steps_per_mm[axis];
+      }
+      frame_xyzet(position.asLogical(), state.extruder);
+    }
+    break;
+
+  case HeartbeatSelection::RELMODE:
+    {
+      uint8_t rel = 0;
+      LOOP_XYZE(axis)
+      {
+        if (gcode.axis_is_relative(AxisEnum(axis))) SBI(rel, axis);
+      }
+      frame.put8(rel);
+    }
+    break;
+
+  case HeartbeatSelection::DUALX:
+    frame.put8(dual_x_carriage_mode);
+    frame.put8(active_extruder);
+    frame.put_fixed(inactive_extruder_x_pos);
+    break;
+
+  case HeartbeatSelection::ENDSTOPS:
+    {
+      uint8_t es = 0;
+      if (endstops.endstop_state(X_MIN)) SBI(es, 0);
+      if (endstops.endstop_state(Y_MIN)) SBI(es, 1);
+      if (endstops.endstop_state(Z_MIN)) SBI(es, 2);
+      if (endstops.endstop_state(X_MAX)) SBI(es, 3);
+      if (endstops.endstop_state(Y_MAX)) SBI(es, 4);
+      if (endstops.endstop_state(Z_MAX)) SBI(es, 5);
+      frame.put8(es);
+    }
+    break;
+
+  case HeartbeatSelection::DEBUG:
+    frame.put8(GcodeSuite::dbg_current_command_letter);
+    frame.put16(GcodeSuite::dbg_current_command_letter ? GcodeSuite::dbg_current_codenum : 0);
+    frame.put8(
+        (planner.prevent_block_buffering ? _BV(0) : 0)
+      | (planner.prevent_block_extrusion ? _BV(1) : 0)
+    );
+    frame.put8(planner.movesplanned());
+    frame.put8(planner.nonbusy_movesplanned());
+    frame.put16(endstops.live_state);
+    frame.put16(endstops.state());
+    frame.put8(
+        (endstops.enabled ? _BV(0) : 0)
+      | (endstops.enabled_globally ? _BV(1) : 0)
+    );
+    frame.put8(endstops.hit_state);
+    frame.put8(TERN0(RAPIDIA_NOZZLE_PLUG_HYSTERESIS, endstops.z_max_hysteresis_count));
+    frame.put8(TERN0(RAPIDIA_NOZZLE_PLUG_HYSTERESIS, endstops.z_max_hysteresis_threshold));
+    // (zeroes if the task profiler is disabled.)
+    frame.put32(TERN0(RAPIDIA_TASK_PROFILER, TaskProfiler::serial_gap_max_us()));
+    frame.put32(TERN0(RAPIDIA_TASK_PROFILER, TaskProfiler::idle_max_us()));
+    break;
+
+  case HeartbeatSelection::MILEAGE:
+    // (zeroes if mileage is disabled.)
+    // caller must have already loaded mileage.data().
+    for (uint8_t e = 0; e < EXTRUDERS; ++e)
+    {
+      frame.put64(TERN(RAPIDIA_MILEAGE, mileage_to_u64nm(mileage.data().e_mm[e]), 0));
+    }
+    frame.put8(TERN(RAPIDIA_MILEAGE, mileage.get_save_index(), 0));
+    frame.put8(
+        (ENABLED(RAPIDIA_MILEAGE) ? _BV(0) : 0)
+      | (TERN0(RAPIDIA_MILEAGE, mileage.get_expended()) ? _BV(1) : 0)
+    );
+    break;
+
+  default:
+    break;
+  }
+}
+
+// appends the selected fields to the frame, in selection bit order.
+// if delta, fields which are unchanged since they were last sent are dropped again.
+// returns the selection of fields which remain in the frame.
+static HeartbeatSelectionUint frame_fields(const HeartbeatSelectionUint selection, const bool delta)
+{
+  HeartbeatSelectionUint encoded = 0;
+
+  LOOP_L_N(bit, 8)
+  {
+    const HeartbeatSelectionUint field = _BV(bit);
+    if (!(selection & field) || field == static_cast<HeartbeatSelectionUint>(HeartbeatSelection::FEEDRATE))
+    {
+      continue;
+    }
+
+    const uint8_t start = frame.len;
+    Heartbeat::frame_field(static_cast<HeartbeatSelection>(field), static_cast<HeartbeatSelection>(selection));
+
+    if (keyframe_interval_ms)
+    {
+      uint8_t* const cached = field_cache + FRAME_FIELD_OFFSET[bit];
+      const uint8_t n = frame.len - start;
+      if (delta && (cached_fields & field) && !memcmp(cached, frame.buff + start, n))
+      {
+        // unchanged -- drop.
+        frame.len = start;
+        continue;
+      }
+      memcpy(cached, frame.buff + start, n);
+      cached_fields |= field;
+    }
+
+    encoded |= field;
+  }
+
+  // feedrate travels with plan position.
+  if (encoded & static_cast<HeartbeatSelectionUint>(HeartbeatSelection::PLAN_POSITION))
+  {
+    encoded |= selection & static_cast<HeartbeatSelectionUint>(HeartbeatSelection::FEEDRATE);
+  }
+
+  return encoded;
+}
+
+// loads mileage before any output, as mileage.data() may print error text.
+static void preload_mileage(const HeartbeatSelectionUint selection)
+{
+  #if ENABLED(RAPIDIA_MILEAGE)
+    if (TEST_FLAG(selection, HeartbeatSelection::MILEAGE))
+    {
+      mileage.data();
+    }
+  #else
+    UNUSED(selection);
+  #endif
+}
+
+// sends a binary frame of the given type.
+static void send_frame(const uint8_t type, const HeartbeatSelectionUint selection, const bool delta)
+{
+  frame.len = 0;
+  frame.put8(HEARTBEAT_FRAME_START);
+  frame.put8(type);
+  frame.put8(0); // length, filled in below.
+  frame.put8(0); // selection, filled in below.
+
+  const HeartbeatSelectionUint encoded = frame_fields(selection, delta);
+  if (delta && !encoded)
+  {
+    // nothing changed -- nothing to send.
+    Heartbeat::last_frame_bytes = 0;
+    return;
+  }
+
+  frame.buff[2] = frame.len - (FRAME_HEADER_BYTES - 1);
+  frame.buff[3] = encoded;
+
+  uint16_t crc = 0;
+  crc16(&crc, frame.buff, frame.len);
+  frame.put16(crc);
+
+  SERIAL_OUT(write, frame.buff, frame.len);
+
+  Heartbeat::last_frame_bytes = frame.len;
+}
+
+void Heartbeat::serial_info_binary(HeartbeatSelection selection)
+{
+  preload_mileage(static_cast<HeartbeatSelectionUint>(selection));
+  send_frame(HEARTBEAT_FRAME_TYPE, static_cast<HeartbeatSelectionUint>(selection), false);
+}
+
+void Heartbeat::serial_info(HeartbeatSelectionUint selection, HeartbeatEncoding encoding, bool bare)
+{
+  if (encoding == HeartbeatEncoding::BINARY)
+  {
+    serial_info_binary(static_cast<HeartbeatSelection>(selection));
+  }
+  else
+  {
+    if (keyframe_interval_ms)
+    {
+      // keep the delta cache current with what the host has seen.
+      preload_mileage(selection);
+      frame.len = 0;
+      frame_fields(selection, false);
+    }
+    serial_info(static_cast<HeartbeatSelection>(selection), bare);
+  }
+}
+
+void Heartbeat::serial_info_delta(HeartbeatSelectionUint selection, HeartbeatEncoding encoding)
+{
+  preload_mileage(selection);
+
+  if (encoding == HeartbeatEncoding::BINARY)
+  {
+    send_frame(HEARTBEAT_DELTA_FRAME_TYPE, selection, true);
+  }
+  else
+  {
+    frame.len = 0;
+    const HeartbeatSelectionUint changed = frame_fields(selection, true);
+    if (changed)
+    {
+      serial_info(static_cast<HeartbeatSelection>(changed), false, true);
+    }
+    else
+    {
+      last_frame_bytes = 0;
+    }
+  }
+}
+
+void Heartbeat::set_keyframe_interval(uint16_t ms)
+{
+  keyframe_interval_ms = ms;
+  cached_fields = 0;
+  next_keyframe_ms = millis();
+
+  // the delta minimum interval no longer applies.
+  if (!ms && heartbeat_interval_ms)
+  {
+    set_interval(heartbeat_interval_ms);
+  }
+}
+
+uint16_t Heartbeat::get_keyframe_interval()
+{
+  return keyframe_interval_ms;
 }
 
 void Heartbeat::auto_report()
@@ -324,7 +653,23 @@ void Heartbeat::auto_report()
     next_heartbeat_report_ms = millis() + heartbeat_interval_ms;
 
     PORT_REDIRECT(SERIAL_BOTH);
-    serial_info(Heartbeat::selection);
+
+    if (keyframe_interval_ms)
+    {
+      if (ELAPSED(millis(), next_keyframe_ms))
+      {
+        next_keyframe_ms = millis() + keyframe_interval_ms;
+        serial_info(Heartbeat::selection, Heartbeat::encoding);
+      }
+      else
+      {
+        serial_info_delta(Heartbeat::selection, Heartbeat::encoding);
+      }
+    }
+    else
+    {
+      serial_info(Heartbeat::selection, Heartbeat::encoding);
+    }
   }
 }
 
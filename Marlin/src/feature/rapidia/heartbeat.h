@@ -24,35 +24,85 @@ enum class HeartbeatSelection : HeartbeatSelectionUint
   _ALL = 0xff
 };
 
+// how heartbeat frames are written to serial.
+enum class HeartbeatEncoding : uint8_t
+{
+  TEXT,   // H:{...} json line (checksummed per checksum_mode_out)
+  BINARY  // STX-framed, length-prefixed, CRC16-checked binary record
+};
+
+// binary heartbeat frame (multi-byte values are little-endian):
+//   STX 'H' <len:u8> <selection:u8> <fields...> <crc16:u16>
+// len counts the bytes from selection to the last field (inclusive);
+// crc16 (XMODEM) covers everything from STX to the last field.
+// fields appear in HeartbeatSelection bit order, for each bit set in selection.
+constexpr uint8_t HEARTBEAT_FRAME_START = 0x02; // STX
+constexpr uint8_t HEARTBEAT_FRAME_TYPE = 'H';
+
+// delta frames have the same layout, but selection only lists
+// the fields which changed since they were last sent.
+constexpr uint8_t HEARTBEAT_DELTA_FRAME_TYPE = 'D';
+
+// positions/feedrates in binary frames are int32 in units of 1/HEARTBEAT_FIXED_POINT mm.
+constexpr int32_t HEARTBEAT_FIXED_POINT = 1000;
+
 class Heartbeat
 {
 public:
   static HeartbeatSelectionUint selection;
+  static HeartbeatEncoding encoding;
+
+  // size in bytes of the most recently sent heartbeat frame
+  // (0 if unknown, i.e. text frame without RAPIDIA_CHECKSUMS.)
+  static uint16_t last_frame_bytes;
   
   // checks for heartbeat timer elapsed, if so, sends heartbeat message.
   static void auto_report();
 
   // sets heartbeat interval.
   static void set_interval(uint16_t ms);
+
+  // enables delta mode: auto-reported heartbeats only contain fields which
+  // changed since they were last sent, and a full heartbeat (keyframe) is
+  // sent every ms milliseconds so that a reconnecting host can resync.
+  // 0 disables delta mode.
+  static void set_keyframe_interval(uint16_t ms);
+  static uint16_t get_keyframe_interval();
   
   // sends status message
   // selection: what status to send
   // bare: if false, wrap message in H:{ on the left and } on the right"
+  // delta: wrap in HD:{ instead (message only contains changed fields.)
   //
   // note: if Mileage is included in the heartbeat selection, it's possible for
   // error text to be printed out. To avoid this, invoke Rapidia::mileage.data() beforehand
   // (which may cause error text).
-  static void serial_info(HeartbeatSelection selection, bool bare=false);
+  static void serial_info(HeartbeatSelection selection, bool bare=false, bool delta=false);
 
   static inline void serial_info(HeartbeatSelectionUint selection, bool bare=false)
   {
     serial_info(static_cast<HeartbeatSelection>(selection));
   }
 
+  // sends status message in the given encoding.
+  // (bare is ignored for binary frames.)
+  static void serial_info(HeartbeatSelectionUint selection, HeartbeatEncoding encoding, bool bare=false);
+
+  // sends status message as a binary frame (see HEARTBEAT_FRAME_START)
+  static void serial_info_binary(HeartbeatSelection selection);
+
+  // sends only the selected fields which changed since they were last sent.
+  // (sends nothing if no field changed.)
+  static void serial_info_delta(HeartbeatSelectionUint selection, HeartbeatEncoding encoding);
+
   #if ENABLED(RAPIDIA_PAUSE)
     // displays a message when block buffering/extrusion prevention ends after pause.
     static void pause_block_buffering_info();
   #endif
+
+  // appends a single field to the binary frame being built.
+  // (selection is consulted for field modifiers, i.e. FEEDRATE.)
+  static void frame_field(HeartbeatSelection field, HeartbeatSelection selection);
 };
 
 extern Heartbeat heartbeat;
@@ -0,0 +1,58 @@
+#include "isr_profiler.h"
+
+#if ENABLED(RAPIDIA_ISR_PROFILER)
+
+#include "../../module/stepper.h"
+
+namespace Rapidia
+{
+IsrPhaseStats IsrProfiler::stats[ISR_PHASE_COUNT];
+uint32_t IsrProfiler::overruns;
+uint32_t IsrProfiler::loop_limits;
+
+void IsrPhaseStats::record(const hal_timer_t ticks)
+{
+  if (!count || ticks < min) min = ticks;
+  if (ticks > max) max = ticks;
+
+  // halve rather than overflow, which keeps the mean and the shape of the histogram.
+  if (sum + ticks < sum)
+  {
+    sum >>= 1;
+    count >>= 1;
+  }
+  sum += ticks;
+  ++count;
+
+  uint8_t bucket = 0;
+  for (hal_timer_t t = ticks; t && bucket < ISR_HISTOGRAM_BUCKETS - 1; t >>= 1) ++bucket;
+
+  if (histogram[bucket] == UINT16_MAX)
+  {
+    for (uint8_t i = 0; i < ISR_HISTOGRAM_BUCKETS; ++i) histogram[i] >>= 1;
+  }
+  ++histogram[bucket];
+}
+
+void IsrProfiler::snapshot(IsrPhaseStats (&out)[ISR_PHASE_COUNT], uint32_t& out_overruns, uint32_t& out_loop_limits)
+{
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  DISABLE_STEPPER_DRIVER_INTERRUPT();
+  memcpy(out, stats, sizeof(stats));
+  out_overruns = overruns;
+  out_loop_limits = loop_limits;
+  if (isr_enabled) ENABLE_STEPPER_DRIVER_INTERRUPT();
+}
+
+void IsrProfiler::reset()
+{
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  DISABLE_STEPPER_DRIVER_INTERRUPT();
+  memset(stats, 0, sizeof(stats));
+  overruns = 0;
+  loop_limits = 0;
+  if (isr_enabled) ENABLE_STEPPER_DRIVER_INTERRUPT();
+}
+}
+
+#endif
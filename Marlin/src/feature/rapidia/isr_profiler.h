@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(RAPIDIA_ISR_PROFILER)
+namespace Rapidia
+{
+
+// phases of Stepper::isr(), timed with the step timer counter.
+enum isr_phase_t : uint8_t
+{
+  ISR_PHASE_PULSE,
+  ISR_PHASE_ADVANCE,  // (LIN_ADVANCE only)
+  ISR_PHASE_BLOCK,
+  ISR_PHASE_TOTAL,    // whole ISR, including the phases above and the profiler itself
+  ISR_PHASE_COUNT
+};
+
+// bucket 0 counts 0 ticks, bucket i counts [2^(i-1), 2^i) ticks,
+// and the last bucket also counts anything longer.
+constexpr uint8_t ISR_HISTOGRAM_BUCKETS = 16;
+
+struct IsrPhaseStats
+{
+  uint32_t count;
+  uint32_t sum;
+  hal_timer_t min;
+  hal_timer_t max;
+  uint16_t histogram[ISR_HISTOGRAM_BUCKETS];
+
+  void record(const hal_timer_t ticks);
+};
+
+class IsrProfiler
+{
+public:
+  // (called from the stepper ISR.)
+  static inline void record(const isr_phase_t phase, const hal_timer_t ticks) { stats[phase].record(ticks); }
+
+  // the stepper ISR looped straight into another pass because the next deadline had already passed.
+  static inline void overrun() { ++overruns; }
+
+  // ... and gave up after max_loops passes, scheduling the next ISR from now.
+  static inline void loop_limit() { ++loop_limits; }
+
+  // copies the counters out, with the stepper ISR held off.
+  static void snapshot(IsrPhaseStats (&out)[ISR_PHASE_COUNT], uint32_t& out_overruns, uint32_t& out_loop_limits);
+  static void reset();
+
+private:
+  static IsrPhaseStats stats[ISR_PHASE_COUNT];
+  static uint32_t overruns;
+  static uint32_t loop_limits;
+};
+
+}
+
+// times STATEMENT as the given phase of the stepper ISR.
+#define RAPIDIA_ISR_PROFILE(PHASE, STATEMENT) do{ \
+    const hal_timer_t _isr_profile_start = HAL_timer_get_count(STEP_TIMER_NUM); \
+    STATEMENT; \
+    Rapidia::IsrProfiler::record(PHASE, HAL_timer_get_count(STEP_TIMER_NUM) - _isr_profile_start); \
+  }while(0)
+
+#else
+
+#define RAPIDIA_ISR_PROFILE(PHASE, STATEMENT) STATEMENT
+
+#endif
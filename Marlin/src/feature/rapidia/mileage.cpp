@@ -5,6 +5,7 @@
 #include "../../HAL/HAL.h"
 #include "../../libs/crc16.h"
 #include "../../MarlinCore.h"
+#include "../../module/planner.h"
 
 #if ENABLED(RAPIDIA_MILEAGE)
 
@@ -14,54 +15,114 @@ namespace Rapidia
   #define CANARY_1 0xde8bfaed
   #define CANARY_2 0xb8fd7fa1
 
-  struct MileageHeader
+  // the journal header has its own canary, so that the single-slot format
+  // which preceded it can still be recognized and migrated.
+  #define JOURNAL_CANARY_2 0xb8fd7fa2
+  #define JOURNAL_VERSION 1
+
+  // header used before the journal. Only slot save_index held data.
+  struct LegacyMileageHeader
   {
     uint32_t canary_1;
     uint8_t save_index;
     uint8_t save_index_xor;
     uint32_t canary_2;
     uint16_t crc;
+  };
 
-    // return false if no error.
-    bool is_valid()
+  struct LegacyMileageData
+  {
+    mileage_amount_t e_mm[EXTRUDERS];
+    uint16_t crc;
+
+    bool crc_check()
+    {
+      uint16_t z = 0;
+      crc16(&z, this, (const uint8_t*)&crc - (const uint8_t*)this);
+      return z == crc;
+    }
+  };
+
+  // describes the journal layout. This is written once, when the journal
+  // is formatted -- saves only write to the record slots.
+  struct MileageHeader
+  {
+    uint32_t canary_1;
+    uint8_t version;
+    uint8_t slot_count;
+    uint16_t record_size;
+    uint32_t canary_2;
+    uint16_t crc;
+
+    uint16_t calc_crc()
     {
-      if (canary_1 != CANARY_1) return false;
-      if (canary_2 != CANARY_2) return false;
       uint16_t _c = 0;
-      crc16(&_c, this, sizeof(this) - sizeof(crc));
-      if (_c != crc) return false;
-      return (save_index_xor^save_index != 0xff);
+      crc16(&_c, this, (const uint8_t*)&crc - (const uint8_t*)this);
+      return _c;
+    }
+
+    // return true if this header matches the configured journal layout.
+    bool is_valid()
+    {
+      return canary_1 == CANARY_1
+        && canary_2 == JOURNAL_CANARY_2
+        && version == JOURNAL_VERSION
+        && slot_count == RAPIDIA_MILEAGE_SAVE_MULTIPLICITY
+        && record_size == sizeof(MileageData)
+        && crc == calc_crc();
     }
 
     void make_valid()
     {
       canary_1 = CANARY_1;
-      canary_2 = CANARY_2;
-      save_index_xor = ~save_index;
-      crc = 0;
-      crc16(&crc, this, sizeof(this) - sizeof(crc));
+      canary_2 = JOURNAL_CANARY_2;
+      version = JOURNAL_VERSION;
+      slot_count = RAPIDIA_MILEAGE_SAVE_MULTIPLICITY;
+      record_size = sizeof(MileageData);
+      crc = calc_crc();
     }
   };
 
 #define MILEAGE_HEADER_START RAPIDIA_MILEAGE_EEPROM_START
 #define MILEAGE_HEADER_SIZE sizeof(Rapidia::MileageHeader)
 #define MILEAGE_DATA_START (RAPIDIA_MILEAGE_EEPROM_START + MILEAGE_HEADER_SIZE)
+#define LEGACY_DATA_START (RAPIDIA_MILEAGE_EEPROM_START + sizeof(Rapidia::LegacyMileageHeader))
 
 #define RAPIDIA_MILEAGE_MAX_SIZE (E2END + 1 - RAPIDIA_MILEAGE_EEPROM_START)
 #define RAPIDIA_MILEAGE_SIZE_FULL (RAPIDIA_MILEAGE_SAVE_MULTIPLICITY * (sizeof(Rapidia::MileageData)) + MILEAGE_HEADER_SIZE)
 
+#ifndef RAPIDIA_MILEAGE_EEPROM_ENDURANCE
+  #define RAPIDIA_MILEAGE_EEPROM_ENDURANCE 100000
+#endif
+
 static_assert(RAPIDIA_MILEAGE_SIZE_FULL < RAPIDIA_MILEAGE_MAX_SIZE, "Insufficient room for mileage store in eeprom");
+static_assert(RAPIDIA_MILEAGE_SAVE_MULTIPLICITY <= 0xff, "RAPIDIA_MILEAGE_SAVE_MULTIPLICITY must fit in a uint8_t.");
 
 Mileage milage;
-decltype(Mileage::e_mm_tally) Mileage::e_mm_tally{ 0, 0 };
+int32_t Mileage::e_steps_tally[EXTRUDERS]{ 0 };
+float Mileage::e_nm_residual[EXTRUDERS]{ 0 };
 MileageData Mileage::_data;
 millis_t Mileage::save_interval_ms = SEC_TO_MS(RAPIDIA_MILEAGE_SAVE_INTERVAL);
 millis_t Mileage::next_save_time_ms = 0;
+bool Mileage::dirty = false;
 
 // TODO: make these class members (for neatness)
 static bool is_loaded = false;
 static bool is_expended = false;
-static size_t save_index = 0;
+static bool is_formatted = false;
+
+// slot holding the newest record, and that record's sequence number.
+// (sequence 0 means no record has been written yet.)
+static uint8_t save_index = RAPIDIA_MILEAGE_SAVE_MULTIPLICITY - 1;
+static uint32_t sequence = 0;
+
+// slots which failed to write this session. These are skipped by saves.
+static uint8_t bad_slots[(RAPIDIA_MILEAGE_SAVE_MULTIPLICITY + 7) / 8];
+
+static inline int slot_pos(const uint8_t slot)
+{
+  return MILEAGE_DATA_START + slot * sizeof(MileageData);
+}
 
 bool memeq(const void* _v, uint8_t val, size_t length)
 {
@@ -83,7 +144,8 @@ void Mileage::update()
   {
     next_save_time_ms = now + save_interval_ms;
 
-    save_eeprom();
+    // nothing extruded since the last save -- don't spend a write.
+    if (dirty) save_eeprom();
   }
 }
 
@@ -100,23 +162,41 @@ MileageData& Mileage::data()
 void Mileage::add_tally()
 {
   // copy tally to temporary variable and reset tally to 0.
-  decltype(e_mm_tally) tally_copy;
+  decltype(e_steps_tally) tally_copy;
   cli();
-  memcpy(&tally_copy, &e_mm_tally, sizeof(tally_copy));
-  memset(&e_mm_tally, 0, sizeof(e_mm_tally));
+  memcpy(&tally_copy, &e_steps_tally, sizeof(tally_copy));
+  memset(&e_steps_tally, 0, sizeof(e_steps_tally));
   sei();
   
   // add these values to the mileage data.
-  for (size_t e = 0; e < EXTRUDERS; ++e)
+  for (uint8_t e = 0; e < EXTRUDERS; ++e)
   {
-    const mileage_amount_t distance_mm = tally_copy[e];
-    data().e_mm[e] += distance_mm;
+    if (!tally_copy[e]) continue;
+
+    // (the residual keeps frequent small conversions from drifting.)
+    const float nm = tally_copy[e] * (planner.steps_to_mm[E_AXIS_N(e)] * MILEAGE_FIXED_PRECISION) + e_nm_residual[e];
+    const int32_t whole_nm = int32_t(nm);
+    e_nm_residual[e] = nm - whole_nm;
+
+    mileage_amount_t& e_mm = data().e_mm[e];
+    if (whole_nm >= 0)
+    {
+      e_mm += whole_nm;
+    }
+    else
+    {
+      // can't store negative mileage.
+      const mileage_amount_t retracted = -whole_nm;
+      e_mm = (e_mm > retracted) ? e_mm - retracted : 0;
+    }
+    dirty = true;
   }
 }
 
 bool Mileage::header_is_empty()
 {
   uint8_t buff[sizeof(MileageHeader)];
+  if (persistentStore.read(MILEAGE_HEADER_START, buff)) return false;
   if (memeq(buff, 0xff, sizeof(MileageHeader))) return true;
   if (memeq(buff, 0, sizeof(MileageHeader))) return true;
   return false;
@@ -129,7 +209,7 @@ bool Mileage::read_header()
   if (persistentStore.read(MILEAGE_HEADER_START, hdr)) return true;
   if (!hdr.is_valid()) return true;
 
-  save_index = hdr.save_index;
+  is_formatted = true;
 
   return false;
 }
@@ -137,11 +217,16 @@ bool Mileage::read_header()
 bool Mileage::write_header()
 {
   MileageHeader hdr;
-  hdr.save_index = static_cast<uint8_t>(save_index);
-
   hdr.make_valid();
   assert_kill_pgm(hdr.is_valid(), PSTR("failed to make header valid"));
-  return persistentStore.write(MILEAGE_HEADER_START, hdr);
+  if (persistentStore.write(MILEAGE_HEADER_START, hdr)) return true;
+
+  // (the journal starts over from slot 0.)
+  is_formatted = true;
+  save_index = RAPIDIA_MILEAGE_SAVE_MULTIPLICITY - 1;
+  sequence = 0;
+
+  return false;
 }
 
 uint8_t Mileage::get_save_index()
@@ -159,28 +244,98 @@ bool Mileage::get_loaded()
   return is_loaded;
 }
 
-bool Mileage::load_eeprom()
+uint32_t Mileage::get_sequence()
 {
-  if (!is_loaded)
+  return sequence;
+}
+
+uint8_t Mileage::get_usable_slots()
+{
+  uint8_t usable = 0;
+  for (uint8_t slot = 0; slot < RAPIDIA_MILEAGE_SAVE_MULTIPLICITY; ++slot)
   {
-    if (header_is_empty()) return load_fail(ErrorCode::FIRST_TIME);
+    if (!TEST(bad_slots[slot / 8], slot % 8)) ++usable;
+  }
+  return usable;
+}
+
+uint32_t Mileage::get_write_budget()
+{
+  // saves are spread evenly over the slots, so each slot has taken about
+  // sequence / multiplicity writes of its endurance so far.
+  const uint32_t writes_per_slot = sequence / RAPIDIA_MILEAGE_SAVE_MULTIPLICITY;
+  if (writes_per_slot >= RAPIDIA_MILEAGE_EEPROM_ENDURANCE) return 0;
+
+  return uint32_t(get_usable_slots()) * (RAPIDIA_MILEAGE_EEPROM_ENDURANCE - writes_per_slot);
+}
+
+// recovers data stored in the single-slot format which preceded the journal.
+// it is written back out in the journal format on the next save.
+bool Mileage::load_legacy()
+{
+  LegacyMileageHeader hdr;
+  if (persistentStore.read(MILEAGE_HEADER_START, hdr)) return true;
+  if (hdr.canary_1 != CANARY_1 || hdr.canary_2 != CANARY_2) return true;
+  if (hdr.save_index >= RAPIDIA_MILEAGE_SAVE_MULTIPLICITY) return true;
+
+  LegacyMileageData legacy;
+  if (persistentStore.read(LEGACY_DATA_START + hdr.save_index * sizeof(LegacyMileageData), legacy)) return true;
+  if (!legacy.crc_check()) return true;
+
+  memset(&_data, 0, sizeof(_data));
+  memcpy(_data.e_mm, legacy.e_mm, sizeof(_data.e_mm));
+  is_loaded = true;
+  is_formatted = false;
+  dirty = true;
+
+  SERIAL_ECHO_MSG("Migrating mileage data to journal format.");
 
-    if (read_header()) return load_fail(ErrorCode::FORMAT);
+  return false;
+}
+
+// finds the record with the highest sequence number that passes its crc.
+// (if the newest save was interrupted, this recovers the one before it.)
+bool Mileage::load_newest()
+{
+  bool found = false;
+  sequence = 0;
+  save_index = RAPIDIA_MILEAGE_SAVE_MULTIPLICITY - 1;
+
+  for (uint8_t slot = 0; slot < RAPIDIA_MILEAGE_SAVE_MULTIPLICITY; ++slot)
+  {
+    MileageData record;
+    if (persistentStore.read(slot_pos(slot), record)) continue;
+    if (!record.crc_check()) continue;
+    if (record.sequence == 0 || record.sequence == 0xffffffff) continue;
+    if (record.sequence <= sequence) continue;
+
+    found = true;
+    sequence = record.sequence;
+    save_index = slot;
+    _data = record;
   }
 
-  // save_index past end -- no recovery from this.
-  if (save_index >= RAPIDIA_MILEAGE_SAVE_MULTIPLICITY)
+  return !found;
+}
+
+bool Mileage::load_eeprom()
+{
+  if (header_is_empty()) return load_fail(ErrorCode::FIRST_TIME);
+
+  if (read_header())
   {
-    return load_fail(ErrorCode::EXPENDED);
+    // not a journal -- perhaps the format from before the journal.
+    if (load_legacy()) return load_fail(ErrorCode::FORMAT);
+    return false;
   }
 
-  persistentStore.read(MILEAGE_DATA_START + save_index * sizeof(MileageData), _data);
-  if (!_data.crc_check())
+  if (load_newest())
   {
     return load_fail(ErrorCode::CRC_MISMATCH);
   }
 
   is_loaded = true;
+  dirty = false;
 
   return false;
 }
@@ -195,30 +350,42 @@ bool Mileage::save_eeprom()
 
   next_save_time_ms = millis() + save_interval_ms;
 
+  if (!is_formatted && write_header())
+  {
+    return save_fail(ErrorCode::HEADER_DAMAGE);
+  }
+
+  _data.sequence = sequence + 1;
   _data.update_crc();
   assert_kill_pgm(_data.crc_check(), PSTR("data crc fail"));
 
-  // try saving in subsequent slots until one works.
-  for (; save_index < RAPIDIA_MILEAGE_SAVE_MULTIPLICITY; ++save_index)
+  // each save goes to the slot after the newest record, so wear is spread
+  // evenly over all slots and the previous record survives a failed write.
+  uint8_t slot = save_index;
+  for (uint8_t i = 0; i < RAPIDIA_MILEAGE_SAVE_MULTIPLICITY; ++i)
   {
-    int pos = (MILEAGE_DATA_START + save_index * sizeof(MileageData));
-    if (persistentStore.write(pos, _data)) continue;
+    if (++slot >= RAPIDIA_MILEAGE_SAVE_MULTIPLICITY) slot = 0;
+    if (TEST(bad_slots[slot / 8], slot % 8)) continue;
 
-    // read and check CRC
+    // write, then read back to verify.
+    const int pos = slot_pos(slot);
     MileageData check;
-    if (persistentStore.read(pos, check)) continue;
-    if (!check.crc_check()) continue;
-
-    // we've found a spot for the data, so let's write the header.
-    if (write_header()) return save_fail(ErrorCode::HEADER_DAMAGE);
+    if (persistentStore.write(pos, _data)
+      || persistentStore.read(pos, check)
+      || memcmp(&check, &_data, sizeof(check)))
+    {
+      SBI(bad_slots[slot / 8], slot % 8);
+      continue;
+    }
 
     // success!
+    save_index = slot;
+    sequence = _data.sequence;
+    dirty = false;
     return false;
   }
 
   // we've run out of slots.
-  assert_kill_pgm(save_index >= RAPIDIA_MILEAGE_SAVE_MULTIPLICITY, PSTR("save slot multiplicity err"));
-  write_header(); // write the out-of-bounds save index so next time we load we can recognize that the eeprom is spent.
   return save_fail(ErrorCode::EXPENDED);
 }
 
@@ -277,7 +444,11 @@ void Mileage::reset(bool save)
   memset(&_data, 0, sizeof(_data));
   is_loaded = true;
   is_expended = false;
-  save_index = 0;
+  dirty = true;
+
+  // give slots which failed previously another chance.
+  // (the journal itself carries on from the newest record.)
+  memset(bad_slots, 0, sizeof(bad_slots));
 
   // reset save timer too (even if we don't save now).
   next_save_time_ms = millis() + save_interval_ms;
@@ -288,10 +459,11 @@ void Mileage::reset(bool save)
   }
 }
 
+// (covers the members before crc, not the padding some targets put after it.)
 uint16_t MileageData::calc_crc()
 {
   uint16_t z = 0;
-  crc16(&z, this, sizeof(*this) - sizeof(crc));
+  crc16(&z, this, (const uint8_t*)&crc - (const uint8_t*)this);
   return z;
 }
 
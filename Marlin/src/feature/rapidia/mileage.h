@@ -53,6 +53,10 @@ struct MileageData
     // Preserved raw directly from gcode command
     mileage_amount_t e_mm[EXTRUDERS];
 
+    // position of this record in the EEPROM journal (see Mileage::save_eeprom).
+    // 0 and 0xffffffff are never written, so blank EEPROM doesn't pass as a record.
+    uint32_t sequence;
+
     void update_crc();
     bool crc_check();
 
@@ -65,8 +69,9 @@ struct MileageData
 class Mileage
 {
 public:
-    static void increment_e_mm_tally(uint8_t extruder, mileage_amount_t e_mm) {
-      e_mm_tally[extruder] += e_mm;
+    // called from the stepper ISR as blocks finish. (signed -- retraction counts against it.)
+    static inline void increment_e_steps_tally(const uint8_t extruder, const int32_t e_steps) {
+      e_steps_tally[extruder] += e_steps;
     }
 
     static millis_t save_interval_ms;
@@ -81,6 +86,9 @@ public:
     static bool load_eeprom();
     static bool save_eeprom();
 
+    // data() was modified directly; the next update() should save it.
+    static void mark_dirty() { dirty = true; }
+
     // resets mileage (and possibly saves this to eeprom)
     static void reset(bool save=false);
 
@@ -88,11 +96,23 @@ public:
     static bool get_expended();
     static bool get_loaded();
 
+    // number of saves made since the journal was formatted.
+    static uint32_t get_sequence();
+
+    // number of journal slots which have not failed a write this session.
+    static uint8_t get_usable_slots();
+
+    // estimated number of saves left before the usable slots wear out.
+    static uint32_t get_write_budget();
+
 private:
     // contains data for mileage. Can be written as a unit to EEPROM.
     static MileageData _data;
     static millis_t next_save_time_ms;
 
+    // set when the data has changed since it was last saved.
+    static bool dirty;
+
     // reasons why loading/saving can fail.
     enum class ErrorCode {
         CRC_MISMATCH,
@@ -102,19 +122,23 @@ private:
         FIRST_TIME
     };
 
-    // move e step tally into data.
+    // move e step tally into data, converting to nm.
     static void add_tally();
 
     static bool read_header();
     static bool write_header();
     static bool header_is_empty();
+    static bool load_legacy();
+    static bool load_newest();
     static bool load_fail(ErrorCode);
     static bool save_fail(ErrorCode);
     static void fail(ErrorCode); // helper for load_fail and save_fail
 
-    // This is updated in the planner, less accurate that actual stepper isr, but good enough for
-    // the purpose of tracking paste usage.
-    static mileage_amount_t e_mm_tally[EXTRUDERS];
+    // E steps taken since the last add_tally(). Updated by the stepper ISR.
+    static int32_t e_steps_tally[EXTRUDERS];
+
+    // fraction of a nm left over from converting the tally, carried to the next conversion.
+    static float e_nm_residual[EXTRUDERS];
 };
 
 extern Mileage mileage;
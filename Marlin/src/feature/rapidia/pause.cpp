@@ -6,6 +6,10 @@
 #include "../../sd/cardreader.h"
 #include "../../gcode/gcode.h"
 #include "heartbeat.h"
+#include "binary_motion.h"
+#include "serial_line.h"
+
+#include "../../MarlinCore.h"
 
 #if ENABLED(RAPIDIA_PAUSE)
 namespace Rapidia
@@ -14,21 +18,301 @@ Pause pause; // singleton
 
 static uint8_t defer_pause = 0;
 
-static void report_xyzet(const xyze_pos_t &pos, const uint8_t extruder, const uint8_t n=XYZE, const uint8_t precision=3) {
-  char str[12];
-  
+#if ENABLED(SDSUPPORT)
+  // the pause paused an SD print.
+  static bool was_printing_sd = false;
+#endif
+
+static void report_xyzet(SerialLine& line, const xyze_pos_t &pos, const uint8_t extruder, const uint8_t n=XYZE, const uint8_t precision=3) {
   // position.
   LOOP_L_N(a, n) {
-    echo_key(axis_codes[a]);
-    SERIAL_ECHO(dtostrf(pos[a], 1, precision, str));
-    SERIAL_CHAR(',');
+    line.echo_key(axis_codes[a]);
+    line.echo_float(pos[a], precision);
+    line.echo_char(',');
   }
   
   // extruder number
-  echo_key('T');
-  SERIAL_CHAR('0' + extruder);
+  line.echo_key('T');
+  line.echo_char('0' + extruder);
+}
+
+// reports the result of a pause.
+static void report(const long qline, const char command_letter, const int codenum,
+  const Planner::pause_result &result, const Stepper::State &pause_state
+  #if ENABLED(RAPIDIA_STEPPER_PAUSE)
+    , const uint32_t latency_us
+  #endif
+)
+{
+  SerialLine line;
+  LINE_ECHOPGM(line, "pause:{");
+
+  // separator accumulator
+  bool sep = true;
+
+  // line number to report?
+  if (qline != -1)
+  {
+    line.echo_separator(sep);
+    line.echo_key('N');
+    line.echo_dec(qline);
+  }
+
+  // report gcode line that was completed?
+  if (result.line >= 0)
+  {
+    line.echo_separator(sep);
+    line.echo_key('G');
+    line.echo_dec(result.line);
+  }
+
+  // report command that was interrupted by pause?
+  if (command_letter)
+  {
+    line.echo_separator(sep);
+    line.echo_key('I');
+    line.echo_char('"');
+    line.echo_char(command_letter);
+    line.echo_dec(codenum);
+    line.echo_char('"');
+  }
+
+  // did deceleration occur?
+  line.echo_separator(sep);
+  LINE_ECHO_KEY_STR(line, "deceleration");
+  if (!result.deceleration_block)
+  {
+    LINE_ECHOPGM(line, "false");
+
+    // for debugging purposes
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "cropped");
+    if (result.deceleration_cropped)
+    {
+      LINE_ECHOPGM(line, "false");
+    }
+    else
+    {
+      LINE_ECHOPGM(line, "true");
+    }
+  }
+  else
+  {
+    LINE_ECHOPGM(line, "true");
+
+    // distance travelled during deceleration.
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "distance");
+    line.echo_float(result.deceleration_mm, 2);
+  }
+
+  #if ENABLED(RAPIDIA_STEPPER_PAUSE)
+    // time from the pause request to coming to rest.
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "latency");
+    line.echo_dec(latency_us);
+  #endif
+
+  #if ENABLED(SDSUPPORT)
+    // report if the pause occured during an SD print.
+    // (if true, this means the sd print was auto-paused.)
+    line.echo_separator(sep);
+    LINE_ECHO_KEY_STR(line, "sd");
+    if (was_printing_sd)
+    {
+      LINE_ECHOPGM(line, "true");
+    }
+    else
+    {
+      LINE_ECHOPGM(line, "false");
+    }
+    was_printing_sd = false;
+  #endif
+  
+  // report the position from immediately before pausing.
+  line.echo_separator(sep);
+  line.echo_key('P');
+  line.echo_char('{');
+  
+  xyze_pos_t position;
+  LOOP_XYZE(axis)
+  {
+    position[axis] = pause_state.position[axis] / planner.settings.axis_steps_per_mm[axis];
+  }
+
+  report_xyzet(line, position.asLogical(), pause_state.extruder);
+  line.echo_char('}');
+  
+  // current position after pausing
+  line.echo_separator(sep);
+  line.echo_key('C');
+  line.echo_char('{');
+  report_xyzet(line, current_position.asLogical(), active_extruder);
+  line.echo_char('}');
+  
+  // end of message
+  line.echo_char('}');
+  line.eol();
+
+}
+
+#if ENABLED(RAPIDIA_STEPPER_PAUSE)
+
+// the pause the stepper ISR is carrying out: what it interrupted, for the report.
+static bool pausing = false;
+static char pause_command_letter;
+static int pause_codenum;
+static long pause_qline;
+
+// takes the commands out of the way of a pause the stepper ISR has been asked for.
+static void begin(const bool hard)
+{
+  if (!pausing)
+  {
+    pausing = true;
+
+    // what command is being interrupted
+    pause_command_letter = GcodeSuite::dbg_current_command_letter;
+    pause_codenum = GcodeSuite::dbg_current_codenum;
+
+    pause_qline = queue.get_first_line_number();
+    #if ENABLED(RAPIDIA_BINARY_MOTION)
+      if (pause_qline == -1) pause_qline = binary_motion.first_line();
+    #endif
+
+    // pause SD card printing
+    #if ENABLED(SDSUPPORT)
+      if (IS_SD_PRINTING())
+      {
+        was_printing_sd = true;
+        card.pauseSDPrint();
+      }
+    #endif
+
+    // no new blocks extrude.
+    // (the ISR stops extrusion in each block it takes while pausing, so the
+    // blocks it doesn't reach are left as they were planned.)
+    planner.prevent_block_extrusion = true;
+  }
+
+  // cancel any gcode higher-up on the callstack.
+  // (a soft pause lets the command being executed finish planning its blocks.)
+  if (hard) planner.prevent_block_buffering = true;
+}
+
+#if ENABLED(RAPIDIA_PAUSE_RESUME)
+
+// what R754 resumes: moves from where extrusion stopped to the end of the gcode the pause interrupted.
+static bool resumable = false;
+static uint8_t resume_extruder;
+static xyz_long_t resume_from;
+static Planner::pause_move_t resume_moves[BLOCK_BUFFER_SIZE];
+static uint8_t resume_count;
+static source_line_t resume_line;
+
+// keeps what a pause interrupted, before the blocks are discarded.
+static void keep_resume(const Stepper::pause_info_t &info)
+{
+  resumable = info.resumable;
+  resume_extruder = active_extruder;
+  resume_count = 0;
+  resume_line = info.line;
+
+  // a soft pause stopped extruding at a gcode's end, but may have carried on past it.
+  if (!info.hard)
+  {
+    resume_from = info.decelerate_from;
+    return;
+  }
+
+  // a hard pause goes back to where extrusion stopped, finishes the interrupted block,
+  // and the rest of its gcode. (the blocks left in the buffer follow it.)
+  resume_from = info.position;
+  const bool interrupted = info.interrupted,
+             to_line_end = !interrupted || info.interrupted_line == NO_SOURCE_LINE;
+  xyz_long_t start;
+  const int8_t count = planner.pause_keep_moves(resume_moves + interrupted, start, resume_line, to_line_end);
+  if (count < 0)
+  {
+    resumable = false;
+    return;
+  }
+  resume_count = interrupted + count;
+
+  if (interrupted)
+  {
+    Planner::pause_move_t &move = resume_moves[0];
+    move.target = start;
+    move.e_steps = info.e_remaining;
+    move.fr_mm_s = SQRT(info.nominal_speed_sqr);
+    if (!to_line_end) resume_line = info.interrupted_line;
+  }
+}
+
+#endif
+
+// the steppers have stopped: drop the blocks left in the buffer, and report.
+static void finish()
+{
+  planner.prevent_block_buffering = true;
+  TERN_(RAPIDIA_PAUSE_RESUME, keep_resume(stepper.pause_info));
+  planner.pause_discard_blocks();
+
+  // new plan position = calculated position from stepper.
+  set_current_from_steppers_for_axis(ALL_AXES);
+  sync_plan_position();
+
+  const Stepper::pause_info_t &info = stepper.pause_info;
+  Planner::pause_result result(info.line);
+  result.deceleration_block = info.decelerated;
+  if (info.decelerated)
+  {
+    // distance travelled during deceleration.
+    const Stepper::State stopped = stepper.report_state();
+    result.deceleration_mm = SQRT(
+        sq((stopped.position.a - info.decelerate_from.a) * planner.steps_to_mm[A_AXIS])
+      + sq((stopped.position.b - info.decelerate_from.b) * planner.steps_to_mm[B_AXIS])
+      + sq((stopped.position.c - info.decelerate_from.c) * planner.steps_to_mm[C_AXIS])
+    );
+  }
+
+  const Stepper::State taken = { info.position, active_extruder };
+  report(pause_qline, pause_command_letter, pause_codenum, result, taken, info.stop_us - info.request_us);
+
+  // pause complete.
+  // (we need to send an ok from this routine because
+  // the emergency parser doesn't send an ok.)
+  queue.ok_to_send();
+
+  pausing = false;
+  stepper.pause_release();
 }
 
+// called from idle while pausing.
+static void update()
+{
+  // process no further commands.
+  queue.clear_with_oks(1);
+  TERN_(RAPIDIA_BINARY_MOTION, binary_motion.clear());
+
+  // (cleared by the main loop on each pass.)
+  planner.prevent_block_extrusion = true;
+  if (stepper.pause_state >= Stepper::PAUSE_NOW) planner.prevent_block_buffering = true;
+
+  if (stepper.pause_stopped()) finish();
+}
+
+void Pause::pause(bool hard)
+{
+  stepper.pause(hard);
+  begin(hard);
+
+  // Wait for the steppers to decelerate and come to a complete rest.
+  while (pausing) idle();
+}
+
+#else
+
 void Pause::pause(bool hard)
 {
   #ifdef RAPIDIA_PAUSE_DEBUG
@@ -57,10 +341,12 @@ void Pause::pause(bool hard)
   Stepper::State pause_state = stepper.report_state();
   
   long qline = queue.get_first_line_number();
+  #if ENABLED(RAPIDIA_BINARY_MOTION)
+    if (qline == -1) qline = binary_motion.first_line();
+  #endif
   
   // pause SD card printing
   #if ENABLED(SDSUPPORT)
-    static bool was_printing_sd = false;
     if (IS_SD_PRINTING())
     {
       was_printing_sd = true;
@@ -70,6 +356,7 @@ void Pause::pause(bool hard)
 
   // process no further commands.
   queue.clear_with_oks(1);
+  TERN_(RAPIDIA_BINARY_MOTION, binary_motion.clear());
 
   // tell planner to pause.
   Planner::pause_result result = planner.pause_decelerate(hard);
@@ -112,107 +399,7 @@ void Pause::pause(bool hard)
   sync_plan_position();
   
   // report pause result.
-  SERIAL_ECHO("pause:{");
-
-  // separator accumulator
-  bool sep = true;
-
-  // line number to report?
-  if (qline != -1)
-  {
-    echo_separator(sep);
-    echo_key('N');
-    SERIAL_ECHO(qline);
-  }
-
-  // report gcode line that was completed?
-  if (result.line >= 0)
-  {
-    echo_separator(sep);
-    echo_key('G');
-    SERIAL_ECHO(result.line);
-  }
-
-  // report command that was interrupted by pause?
-  if (command_letter)
-  {
-    char sbuff[32];
-    if (sprintf(sbuff, "\"%c%d\"", command_letter, codenum) > 0)
-    {
-      echo_separator(sep);
-      echo_key('I');
-      SERIAL_ECHO(sbuff);
-    }
-  }
-
-  // did deceleration occur?
-  echo_separator(sep);
-  echo_key_str("deceleration");
-  if (!result.deceleration_block)
-  {
-    SERIAL_ECHO("false");
-
-    // for debugging purposes
-    echo_separator(sep);
-    echo_key_str("cropped");
-    if (result.deceleration_cropped)
-    {
-      SERIAL_ECHO("false");
-    }
-    else
-    {
-      SERIAL_ECHO("true");
-    }
-  }
-  else
-  {
-    SERIAL_ECHO("true");
-
-    // distance travelled during deceleration.
-    echo_separator(sep);
-    echo_key_str("distance");
-    SERIAL_ECHO(result.deceleration_mm);
-  }
-
-  #if ENABLED(SDSUPPORT)
-    // report if the pause occured during an SD print.
-    // (if true, this means the sd print was auto-paused.)
-    echo_separator(sep);
-    echo_key_str("sd");
-    if (was_printing_sd)
-    {
-      SERIAL_ECHO("true");
-    }
-    else
-    {
-      SERIAL_ECHO("false");
-    }
-    was_printing_sd = false;
-  #endif
-  
-  // report the position from immediately before pausing.
-  echo_separator(sep);
-  echo_key('P');
-  SERIAL_CHAR('{');
-  
-  xyze_pos_t position;
-  LOOP_XYZE(axis)
-  {
-    position[axis] = pause_state.position[axis] / planner.settings.axis_steps_per_mm[axis];
-  }
-
-  report_xyzet(position.asLogical(), pause_state.extruder);
-  SERIAL_CHAR('}');
-  
-  // current position after pausing
-  echo_separator(sep);
-  echo_key('C');
-  SERIAL_CHAR('{');
-  report_xyzet(current_position.asLogical(), active_extruder);
-  SERIAL_CHAR('}');
-  
-  // end of message
-  SERIAL_ECHOLN("}");
+  report(qline, command_letter, codenum, result, pause_state);
 
   // pause complete.
   // (we need to send an ok from this routine because
@@ -228,9 +415,14 @@ void Pause::pause(bool hard)
   is_pausing = false;
 }
 
+#endif // RAPIDIA_STEPPER_PAUSE
+
 void Pause::defer(bool hard)
 {
   defer_pause = hard + 1;
+
+  // (the steppers start decelerating straight away; the rest waits for idle.)
+  TERN_(RAPIDIA_STEPPER_PAUSE, stepper.pause(hard));
 }
 
 void Pause::process_deferred()
@@ -238,6 +430,14 @@ void Pause::process_deferred()
   static bool pause_in_progress = false;
   if (pause_in_progress) return;
   pause_in_progress = true;
+  #if ENABLED(RAPIDIA_STEPPER_PAUSE)
+    if (defer_pause)
+    {
+      begin(defer_pause == 2);
+      defer_pause = 0;
+    }
+    if (pausing) update();
+  #else
   switch (defer_pause)
   {
   case 1: // soft
@@ -253,8 +453,88 @@ void Pause::process_deferred()
   default:
     break;
   }
+  #endif
   pause_in_progress = false;
 }
 
+#if ENABLED(RAPIDIA_PAUSE_RESUME)
+
+// whether the soft endstops (which keep X clear of the other carriage) let the print head go to a position (steps).
+static bool within_limits(const xyz_long_t &steps)
+{
+  xyze_pos_t pos = current_position;
+  LOOP_XYZ(axis) pos[axis] = steps[axis] * planner.steps_to_mm[axis];
+  TERN_(HAS_POSITION_MODIFIERS, planner.unapply_modifiers(pos, true));
+  xyz_pos_t limited = pos;
+  apply_motion_limits(limited);
+  LOOP_XYZ(axis) if (ABS(limited[axis] - pos[axis]) > planner.steps_to_mm[axis]) return false;
+  return true;
+}
+
+void Pause::resume()
+{
+  SerialLine line;
+  LINE_ECHOPGM(line, "resume:{");
+  LINE_ECHO_KEY_STR(line, "resumed");
+
+  // (nothing to resume, or it was for another extruder. or the soft endstops, e.g. the other
+  // carriage, are now in the way: the host can clear it and try again.)
+  bool reachable = within_limits(resume_from);
+  LOOP_L_N(i, resume_count) reachable = reachable && within_limits(resume_moves[i].target);
+  if (!resumable || resume_extruder != active_extruder || !reachable)
+  {
+    LINE_ECHOPGM(line, "false}");
+    line.eol();
+    return;
+  }
+  resumable = false;
+
+  const uint8_t extruder = active_extruder;
+  const feedRate_t fr_mm_s = resume_count ? resume_moves[0].fr_mm_s : feedrate_mm_s;
+  abce_pos_t target = current_position;
+
+  // back to where the pause left off, from wherever the print head is now:
+  // across at the higher of the two heights, then down to it.
+  LOOP_XYZ(axis) target[axis] = planner.position[axis] * planner.steps_to_mm[axis];
+  target.z = _MAX(planner.position.z, resume_from.z) * planner.steps_to_mm[Z_AXIS];
+  planner.buffer_segment(target, fr_mm_s, extruder);
+  target.x = resume_from.x * planner.steps_to_mm[X_AXIS];
+  target.y = resume_from.y * planner.steps_to_mm[Y_AXIS];
+  planner.buffer_segment(target, fr_mm_s, extruder);
+  target.z = resume_from.z * planner.steps_to_mm[Z_AXIS];
+  planner.buffer_segment(target, fr_mm_s, extruder);
+
+  // then along the rest of the interrupted gcode, as it was planned.
+  // (block E steps include the flow factor, which buffer_segment applies again.)
+  LOOP_L_N(i, resume_count)
+  {
+    const Planner::pause_move_t &move = resume_moves[i];
+    LOOP_XYZ(axis) target[axis] = move.target[axis] * planner.steps_to_mm[axis];
+    if (move.e_steps && planner.e_factor[extruder])
+      target.e += move.e_steps * planner.steps_to_mm[E_AXIS_N(extruder)] / planner.e_factor[extruder];
+    planner.buffer_segment(target, move.fr_mm_s, extruder);
+  }
+  #if ENABLED(RAPIDIA_BLOCK_SOURCE)
+    if (resume_count) planner.mark_block(resume_line);
+  #endif
+
+  current_position = target;
+  TERN_(HAS_POSITION_MODIFIERS, planner.unapply_modifiers(current_position, true));
+
+  LINE_ECHOPGM(line, "true,");
+  LINE_ECHO_KEY_STR(line, "moves");
+  line.echo_dec(resume_count);
+  if (resume_count && resume_line >= 0)
+  {
+    line.echo_char(',');
+    line.echo_key('G');
+    line.echo_dec(resume_line);
+  }
+  line.echo_char('}');
+  line.eol();
+}
+
+#endif
+
 }
 #endif
\ No newline at end of file
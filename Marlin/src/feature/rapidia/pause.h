@@ -12,6 +12,11 @@ class Pause
     static void pause(bool hard);
     static void defer(bool hard); // pauses next idle update
     static void process_deferred();
+
+    #if ENABLED(RAPIDIA_PAUSE_RESUME)
+      // replans what the last pause interrupted (R754).
+      static void resume();
+    #endif
 };
   
 extern Pause pause;
@@ -0,0 +1,83 @@
+#include "serial_line.h"
+
+#if ENABLED(RAPIDIA)
+
+namespace Rapidia
+{
+void SerialLine::echo(const char* s)
+{
+  while (*s) echo_char(*s++);
+}
+
+void SerialLine::echo_P(PGM_P s)
+{
+  while (const char c = pgm_read_byte(s++)) echo_char(c);
+}
+
+void SerialLine::echo_dec(const int32_t v)
+{
+  char cbuff[11];
+  if (v < 0) echo_char('-');
+  echo(_sprint_dec(cbuff, v < 0 ? -(uint32_t)v : (uint32_t)v, sizeof(cbuff) - 1));
+}
+
+void SerialLine::echo_hex(const uint32_t v, const uint8_t digits, const bool zeropad)
+{
+  char cbuff[9];
+  echo(_sprint_hex(cbuff, v, _MIN(digits, sizeof(cbuff) - 1), zeropad));
+}
+
+void SerialLine::echo_float(const float v, const uint8_t precision)
+{
+  char cbuff[21];
+  echo(dtostrf(v, 1, precision, cbuff));
+}
+
+void SerialLine::echo_key(const char c)
+{
+  echo_char('"');
+  echo_char(c);
+  echo_char('"');
+  echo_char(':');
+}
+
+void SerialLine::echo_key_P(PGM_P s)
+{
+  echo_char('"');
+  echo_P(s);
+  echo_char('"');
+  echo_char(':');
+}
+
+void SerialLine::send()
+{
+  if (!len) return;
+
+  // (one pass over the buffer, rather than one per echo.)
+  TERN_(RAPIDIA_CHECKSUMS, checksum(crc, buff, len));
+
+  SERIAL_OUT(write, reinterpret_cast<const uint8_t*>(buff), len);
+  sent += len;
+  len = 0;
+}
+
+void SerialLine::eol()
+{
+  #if ENABLED(RAPIDIA_CHECKSUMS)
+    // make room for "*XXXX\n" so the line goes out in one write if possible.
+    if (size_t(len) + 7 > sizeof(buff)) send();
+    checksum(crc, buff, len);
+    len += checksum_suffix(buff + len, crc);
+    crc = 0;
+  #else
+    if (len >= sizeof(buff)) send();
+  #endif
+
+  buff[len++] = '\n';
+  SERIAL_OUT(write, reinterpret_cast<const uint8_t*>(buff), len);
+  sent += len;
+  len = 0;
+}
+}
+
+#endif
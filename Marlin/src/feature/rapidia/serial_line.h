@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../../inc/MarlinConfigPre.h"
+#include "../../core/serial.h"
+#include "checksum.h"
+
+#if ENABLED(RAPIDIA)
+
+// size of the stack buffer a SerialLine accumulates into.
+// (longer lines are written out in pieces of this size.)
+#ifndef RAPIDIA_SERIAL_LINE_SIZE
+  #define RAPIDIA_SERIAL_LINE_SIZE 96
+#endif
+
+namespace Rapidia
+{
+// accumulates one line of serial output in a local buffer, then hands it to
+// the serial port in one write at eol(), followed by the output checksum (R732).
+class SerialLine
+{
+public:
+  SerialLine() {}
+
+  void echo(const char* s);
+  void echo_P(PGM_P s);
+  void echo_char(const char c)
+  {
+    if (len >= sizeof(buff)) send();
+    buff[len++] = c;
+  }
+  void echo_dec(const int32_t v);
+  void echo_hex(const uint32_t v, const uint8_t digits, const bool zeropad=true);
+  void echo_float(const float v, const uint8_t precision=3);
+
+  // echoes json key with quotes and colon
+  void echo_key(const char c);
+  void echo_key_P(PGM_P s);
+
+  // echoes ',' unless this is the first separator.
+  void echo_separator(bool& io_first_separator)
+  {
+    if (!io_first_separator) echo_char(',');
+    io_first_separator = false;
+  }
+
+  // writes out everything accumulated so far, without ending the line.
+  void send();
+
+  // appends the checksum and newline, then writes out the line.
+  void eol();
+
+  // number of bytes written out so far (including checksum and newline).
+  uint16_t bytes() const { return sent; }
+
+private:
+  char buff[RAPIDIA_SERIAL_LINE_SIZE];
+  uint8_t len = 0;
+  uint16_t sent = 0;
+  #if ENABLED(RAPIDIA_CHECKSUMS)
+  checksum_t crc = 0;
+  #endif
+
+  static_assert(RAPIDIA_SERIAL_LINE_SIZE <= 0xff, "RAPIDIA_SERIAL_LINE_SIZE must fit in a uint8_t.");
+};
+}
+
+#define LINE_ECHOPGM(line, s) (line).echo_P(PSTR(s))
+#define LINE_ECHO_KEY_STR(line, s) (line).echo_key_P(PSTR(s))
+
+#endif
@@ -0,0 +1,156 @@
+#include "task_profiler.h"
+
+#if ENABLED(RAPIDIA_TASK_PROFILER)
+
+#include "serial_line.h"
+
+namespace Rapidia
+{
+TaskStats TaskProfiler::stats[TASK_COUNT];
+uint32_t TaskProfiler::idle_count = 0;
+millis_t TaskProfiler::reset_ms = 0;
+uint32_t TaskProfiler::last_serviced_us = 0;
+uint32_t TaskProfiler::gap_max_us = 0;
+char TaskProfiler::gap_letter = 0;
+char TaskProfiler::command_max_letter = 0;
+int TaskProfiler::gap_codenum = 0;
+int TaskProfiler::command_max_codenum = 0;
+
+uint8_t IdleTaskTimer::depth = 0;
+
+static char last_command_letter = 0;
+static int last_command_codenum = 0;
+
+static const char* const task_names[TASK_COUNT] PROGMEM = {
+  PSTR("inactivity"), PSTR("heater"), PSTR("pause"), PSTR("plug"), PSTR("media"), PSTR("ui"),
+  PSTR("report"), PSTR("mileage"), PSTR("line"), PSTR("other"), PSTR("idle"), PSTR("parse"), PSTR("command")
+};
+
+void TaskStats::record(const uint32_t us)
+{
+  NOLESS(max_us, us);
+  total_us += us;
+  while (total_us >= 1000000UL)
+  {
+    total_us -= 1000000UL;
+    ++total_s;
+  }
+}
+
+void TaskProfiler::lap(const task_t task, uint32_t& since)
+{
+  const uint32_t now = micros();
+  stats[task].record(now - since);
+  since = now;
+}
+
+void TaskProfiler::command_done(const char letter, const int codenum, uint32_t& since)
+{
+  const uint32_t before = stats[TASK_COMMAND].max_us;
+  lap(TASK_COMMAND, since);
+  if (stats[TASK_COMMAND].max_us != before)
+  {
+    command_max_letter = letter;
+    command_max_codenum = codenum;
+  }
+  last_command_letter = letter;
+  last_command_codenum = codenum;
+}
+
+void TaskProfiler::serial_serviced()
+{
+  const uint32_t now = micros();
+  if (last_serviced_us)
+  {
+    const uint32_t gap = now - last_serviced_us;
+    if (gap > gap_max_us)
+    {
+      gap_max_us = gap;
+      gap_letter = last_command_letter;
+      gap_codenum = last_command_codenum;
+    }
+  }
+  // (0 marks "not started"; being 1µs off once in 71 minutes doesn't matter.)
+  last_serviced_us = now ? now : 1;
+}
+
+void TaskProfiler::reset()
+{
+  memset(stats, 0, sizeof(stats));
+  idle_count = 0;
+  reset_ms = millis();
+  last_serviced_us = 0;
+  gap_max_us = 0;
+  gap_letter = command_max_letter = 0;
+}
+
+static void echo_command(SerialLine& line, const char letter, const int codenum)
+{
+  line.echo_char('"');
+  if (letter)
+  {
+    line.echo_char(letter);
+    line.echo_dec(codenum);
+  }
+  line.echo_char('"');
+}
+
+void TaskProfiler::report()
+{
+  SerialLine line;
+  LINE_ECHOPGM(line, "tasks:{");
+  LINE_ECHO_KEY_STR(line, "ms");
+  line.echo_dec(millis() - reset_ms);
+
+  line.echo_char(',');
+  LINE_ECHO_KEY_STR(line, "gap");
+  line.echo_char('[');
+  line.echo_dec(gap_max_us);
+  line.echo_char(',');
+  echo_command(line, gap_letter, gap_codenum);
+  line.echo_char(']');
+
+  line.echo_char(',');
+  LINE_ECHO_KEY_STR(line, "n");
+  line.echo_dec(idle_count);
+
+  // "task":[max µs, total ms]
+  for (uint8_t i = 0; i < TASK_COUNT; ++i)
+  {
+    line.echo_char(',');
+    line.echo_key_P((PGM_P)pgm_read_ptr(&task_names[i]));
+    line.echo_char('[');
+    line.echo_dec(stats[i].max_us);
+    line.echo_char(',');
+    line.echo_dec(stats[i].total_ms());
+    if (i == TASK_COMMAND)
+    {
+      line.echo_char(',');
+      echo_command(line, command_max_letter, command_max_codenum);
+    }
+    line.echo_char(']');
+  }
+
+  line.echo_char('}');
+  line.eol();
+}
+
+IdleTaskTimer::IdleTaskTimer()
+{
+  nested = depth++;
+  if (!nested) start_us = last_us = micros();
+}
+
+IdleTaskTimer::~IdleTaskTimer()
+{
+  if (!nested)
+  {
+    lap(TASK_OTHER);
+    TaskProfiler::stats[TASK_IDLE].record(last_us - start_us);
+    ++TaskProfiler::idle_count;
+  }
+  --depth;
+}
+}
+
+#endif
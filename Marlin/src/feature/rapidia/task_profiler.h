@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(RAPIDIA_TASK_PROFILER)
+namespace Rapidia
+{
+
+// main-loop tasks timed by the task profiler (R748).
+enum task_t : uint8_t
+{
+  TASK_INACTIVITY,  // manage_inactivity(), including reading serial into the queue (or staging lines)
+  TASK_HEATER,
+  TASK_PAUSE,
+  TASK_NOZZLE_PLUG,
+  TASK_MEDIA,       // SD / USB insert and remove
+  TASK_UI,
+  TASK_REPORT,      // temperature, heartbeat and SD auto-reports
+  TASK_MILEAGE,
+  TASK_LINE_REPORT, // "Finished executing N..."
+  TASK_OTHER,       // everything else in idle()
+  TASK_IDLE,        // all of idle()
+  TASK_PARSE,       // parser.parse() of queued commands
+  TASK_COMMAND,     // executing queued commands (including any idle() they call)
+  TASK_COUNT
+};
+
+struct TaskStats
+{
+  uint32_t max_us;
+  // total, split so that recording doesn't need a division.
+  uint32_t total_s;
+  uint32_t total_us;
+
+  void record(const uint32_t us);
+  uint32_t total_ms() const { return total_s * 1000UL + total_us / 1000UL; }
+};
+
+class TaskProfiler
+{
+public:
+  // records the time since `since` against task, and restarts `since`.
+  static void lap(const task_t task, uint32_t& since);
+
+  // as lap(), for TASK_COMMAND, remembering which command was slowest.
+  static void command_done(const char letter, const int codenum, uint32_t& since);
+
+  // called each time the main loop services serial input (or finds the command queue full).
+  static void serial_serviced();
+
+  static void reset();
+
+  // one line report, tasks:{...} (see README, R748)
+  static void report();
+
+  // worst gap between serial services since reset, in µs.
+  static uint32_t serial_gap_max_us() { return gap_max_us; }
+  static uint32_t idle_max_us() { return stats[TASK_IDLE].max_us; }
+
+private:
+  friend class IdleTaskTimer;
+  static TaskStats stats[TASK_COUNT];
+  static uint32_t idle_count;
+  static millis_t reset_ms;
+
+  static uint32_t last_serviced_us;
+  static uint32_t gap_max_us;
+  static char gap_letter, command_max_letter;
+  static int gap_codenum, command_max_codenum;
+};
+
+// times one pass of idle(), lap by lap. Nested idle() calls aren't timed
+// separately; they count towards the task of the outer idle() that called them.
+class IdleTaskTimer
+{
+public:
+  IdleTaskTimer();
+  ~IdleTaskTimer();
+  void lap(const task_t task) { if (!nested) TaskProfiler::lap(task, last_us); }
+
+private:
+  static uint8_t depth;
+  bool nested;
+  uint32_t start_us, last_us;
+};
+
+}
+
+#define RAPIDIA_TASK_LAP(TASK) task_timer.lap(Rapidia::TASK)
+
+#else
+
+#define RAPIDIA_TASK_LAP(TASK)
+
+#endif
@@ -61,6 +61,10 @@ GcodeSuite gcode;
   #include "../feature/password/password.h"
 #endif
 
+#if ENABLED(RAPIDIA_TASK_PROFILER)
+  #include "../feature/rapidia/task_profiler.h"
+#endif
+
 #include "../MarlinCore.h" // for idle()
 
 // Inactivity shutdown
@@ -1021,6 +1025,11 @@ void GcodeSuite::process_parsed_command(bool no_ok/*=false*/) {
         case 742: R742(); break;                                  // R742: save mileage immediately
         case 743: R743(); break;                                  // R743: set mileage save interval
         case 744: R744(); break;                                  // R743: edit mileage directly
+        case 747: R747(); break;                                  // R747: report mileage write budget
+      #endif
+
+      #if ENABLED(RAPIDIA_TASK_PROFILER)
+        case 748: R748(); break;                                  // R748: main loop task timing
       #endif
 
       #if ENABLED(RAPIDIA_HOMING_RESET)
@@ -1051,6 +1060,20 @@ void GcodeSuite::process_parsed_command(bool no_ok/*=false*/) {
         case 753: hard_reset_bl(); break;                          // R753: reset to bootloader (also parsed by e_parser)
       #endif
 
+      #if ENABLED(RAPIDIA_PAUSE_RESUME)
+        case 754: R754(); break;                                  // R754: resume a pause
+      #endif
+
+      #if ENABLED(RAPIDIA_BINARY_MOTION)
+        case 760: R760(); break;                                  // R760: switch to binary motion frames
+      #endif
+      #if ENABLED(RAPIDIA_BATCHED_OK)
+        case 761: R761(); break;                                  // R761: batched acknowledgements
+      #endif
+      #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+        case 762: R762(); break;                                  // R762: move the idle X carriage
+      #endif
+
       #if ENABLED(RAPIDIA_DEV)
         case 800:                                                                 // R800: infinite loop
           queue.ok_to_send(); // send an ok before the infinite loop.
@@ -1063,6 +1086,18 @@ void GcodeSuite::process_parsed_command(bool no_ok/*=false*/) {
         case 803: R803(); break; // read EEPROM
         case 804: R804(); break; // write EEPROM
         case 805: R805(); break; // EEPROM integrity scan
+        #if ENABLED(RAPIDIA_CHECKSUMS)
+          case 806: R806(); break; // checksum benchmark
+        #endif
+        #if ENABLED(RAPIDIA_ISR_PROFILER)
+          case 807: R807(); break; // stepper isr profile
+        #endif
+        #if ENABLED(RAPIDIA_REPLAN_STATS)
+          case 808: R808(); break; // planner replan profile
+        #endif
+        #if ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+          case 809: R809(); break; // leveled move segments
+        #endif
       #endif
 
       default: parser.unknown_command_warning(); break;
@@ -1115,14 +1150,27 @@ void GcodeSuite::process_next_command() {
     #endif
   }
 
+  #if ENABLED(RAPIDIA_TASK_PROFILER)
+    uint32_t task_us = micros();
+  #endif
+
   // Parse the next command in the queue
   parser.parse(current_command);
   #if ENABLED(RAPIDIA_BLOCK_SOURCE)
     GcodeSuite::gcode_N = queue.line[queue.index_r];
   #endif
 
+  #if ENABLED(RAPIDIA_TASK_PROFILER)
+    // (the parser may be reused by subcommands.)
+    const char letter = parser.command_letter;
+    const int codenum = parser.codenum;
+    Rapidia::TaskProfiler::lap(Rapidia::TASK_PARSE, task_us);
+  #endif
+
   process_parsed_command();
 
+  TERN_(RAPIDIA_TASK_PROFILER, Rapidia::TaskProfiler::command_done(letter, codenum, task_us));
+
   #if ENABLED(RAPIDIA_BLOCK_SOURCE)
     GcodeSuite::gcode_N = -1;
   #endif
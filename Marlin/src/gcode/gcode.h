@@ -855,8 +855,11 @@ private:
     static void R742(); // save mileage immediately
     static void R743(); // set mileage save interval
     static void R744(); // modify mileage
+    static void R747(); // report mileage write budget
   #endif
 
+  TERN_(RAPIDIA_TASK_PROFILER, static void R748()); // main loop task timing
+
   TERN_(RAPIDIA_HOMING_RESET, static void R745()); // reset homing status
 
   #if ENABLED(RAPIDIA_T1_HOMING)
@@ -874,6 +877,12 @@ private:
     #endif
   #endif
 
+  TERN_(RAPIDIA_PAUSE_RESUME, static void R754()); // resume a pause
+
+  TERN_(RAPIDIA_BINARY_MOTION, static void R760()); // switch to binary motion frames
+  TERN_(RAPIDIA_BATCHED_OK, static void R761()); // batched acknowledgements
+  TERN_(RAPIDIA_IDLE_CARRIAGE, static void R762()); // move the idle X carriage
+
   #if ENABLED(RAPIDIA_DEV)
     static void R733(); // pin test.
     static void R800(); // softlock (infinite loop). (I1: loop as interrupt)
@@ -881,6 +890,10 @@ private:
     static void R803(); // read EEPROM
     static void R804(); // write EEPROM
     static void R805(); // EEPROM integrity scan
+    TERN_(RAPIDIA_CHECKSUMS, static void R806()); // checksum benchmark
+    TERN_(RAPIDIA_ISR_PROFILER, static void R807()); // stepper isr profile
+    TERN_(RAPIDIA_REPLAN_STATS, static void R808()); // planner replan profile
+    TERN_(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS, static void R809()); // leveled move segments
   #endif
 
   TERN_(HAS_BED_PROBE, static void M851());
@@ -173,6 +173,8 @@ void GcodeSuite::M115() {
     cap_line(PSTR("RAPIDIA_PLASTIC"), ENABLED(RAPIDIA_PLASTIC));
     cap_line(PSTR("RAPIDIA_NO_EXTRUDE"), ENABLED(RAPIDIA_NO_EXTRUDE));
     cap_line(PSTR("RAPIDIA_NO_HOTENDS"), ENABLED(RAPIDIA_NO_HOTENDS));
+    cap_line(PSTR("RAPIDIA_BINARY_MOTION"), ENABLED(RAPIDIA_BINARY_MOTION));
+    cap_line(PSTR("RAPIDIA_BATCHED_OK"), ENABLED(RAPIDIA_BATCHED_OK));
 
     // Machine Geometry
     #if ENABLED(M115_GEOMETRY_REPORT)
@@ -45,6 +45,8 @@
  *
  * The arc is approximated by generating many small linear segments.
  * The length of each segment is configured in MM_PER_ARC_SEGMENT (Default 1mm)
+ * (or, with RAPIDIA_ARC_CHORD_TOLERANCE, the longest chord within that distance
+ * of the arc, with MM_PER_ARC_SEGMENT as the minimum).
  * Arcs should only be made relatively large (over 5mm), as larger arcs with
  * larger segments will tend to be more efficient. Your slicer should have
  * options for G2/G3 arc generation. In future these options may be GCode tunable.
@@ -105,7 +107,13 @@ void plan_arc(
 
   // Start with a nominal segment length
   float seg_length = (
-    #ifdef ARC_SEGMENTS_PER_R
+    #ifdef RAPIDIA_ARC_CHORD_TOLERANCE
+      // Longest chord which stays within the tolerance of the arc: 2 * sqrt(t * (2r - t))
+      constrain(
+        radius > (RAPIDIA_ARC_CHORD_TOLERANCE) ? 2 * SQRT((RAPIDIA_ARC_CHORD_TOLERANCE) * (2 * radius - (RAPIDIA_ARC_CHORD_TOLERANCE))) : 0,
+        MM_PER_ARC_SEGMENT, RAPIDIA_ARC_MAX_SEGMENT_MM
+      )
+    #elif defined(ARC_SEGMENTS_PER_R)
       constrain(MM_PER_ARC_SEGMENT * radius, MM_PER_ARC_SEGMENT, ARC_SEGMENTS_PER_R)
     #elif ARC_SEGMENTS_PER_SEC
       _MAX(scaled_fr_mm_s * RECIPROCAL(ARC_SEGMENTS_PER_SEC), MM_PER_ARC_SEGMENT)
@@ -219,10 +227,6 @@ void plan_arc(
       planner.apply_leveling(raw);
     #endif
 
-    SERIAL_ECHO_START();
-    SERIAL_ECHOPGM("Buffering line ");
-    SERIAL_ECHOLN(i);
-
     if (!planner.buffer_line(raw, scaled_fr_mm_s, active_extruder, 0
       #if ENABLED(SCARA_FEEDRATE_SCALING)
         , inv_duration
@@ -279,8 +283,6 @@ void plan_arc(
  *    G3 X20 Y12 R14   ; CCW circle with r=14 ending at X20 Y12
  */
 void GcodeSuite::G2_G3(const bool clockwise) {
-  SERIAL_ECHO_START();
-  SERIAL_ECHOLNPGM("Planning arc");
   if (MOTION_CONDITIONS) {
 
     #if ENABLED(SF_ARC_FIX)
@@ -340,6 +342,7 @@ void GcodeSuite::G2_G3(const bool clockwise) {
       plan_arc(destination, arc_offset, clockwise);
 
       #if ENABLED(RAPIDIA_BLOCK_SOURCE)
+        // (only the final segment of the arc.)
         planner.mark_block(GcodeSuite::gcode_N);
       #endif
 
@@ -52,6 +52,14 @@ GCodeQueue queue;
   #include "../feature/rapidia/pause.h"
 #endif
 
+#if ENABLED(RAPIDIA_BINARY_MOTION)
+  #include "../feature/rapidia/binary_motion.h"
+#endif
+
+#if ENABLED(RAPIDIA_BATCHED_OK)
+  #include "../feature/rapidia/serial_line.h"
+#endif
+
 /**
  * GCode line number handling. Hosts may opt to include line numbers when
  * sending commands to Marlin, and lines will be checked for sequentiality.
@@ -86,6 +94,13 @@ char GCodeQueue::command_buffer[BUFSIZE][MAX_CMD_SIZE];
   long GCodeQueue::line[BUFSIZE];
 #endif
 
+// serial lines waiting for a queue slot.
+#if ENABLED(RAPIDIA_RX_STAGING)
+  GCodeQueue::staged_t GCodeQueue::staged[RAPIDIA_RX_STAGING_LINES];
+  uint8_t GCodeQueue::staged_r, // = 0
+          GCodeQueue::staged_count; // = 0
+#endif
+
 /**
  * Serial command injection
  */
@@ -95,6 +110,17 @@ static int serial_count[NUM_SERIAL] = { 0 };
 
 bool send_ok[BUFSIZE];
 
+#if ENABLED(RAPIDIA_BATCHED_OK)
+  bool GCodeQueue::ok_batching; // = false
+  uint8_t GCodeQueue::ok_batch_count = RAPIDIA_BATCHED_OK_COUNT;
+  uint16_t GCodeQueue::ok_batch_ms = RAPIDIA_BATCHED_OK_MS;
+
+  static uint8_t ok_pending;    // Commands retired since the last ack
+  static long ok_line = -1;     // Line number of the last of them
+  static millis_t ok_since;     // When the first of them was retired
+  static int16_t ok_port;       // The port they came from
+#endif
+
 /**
  * Next Injected PROGMEM Command pointer. (nullptr == empty)
  * Internal commands are enqueued ahead of serial / SD commands.
@@ -115,7 +141,7 @@ GCodeQueue::GCodeQueue() {
  * Check whether there are any commands yet to be executed
  */
 bool GCodeQueue::has_commands_queued() {
-  return queue.length || injected_commands_P || injected_commands[0];
+  return queue.length || injected_commands_P || injected_commands[0] || TERN0(RAPIDIA_RX_STAGING, staged_count);
 }
 
 /**
@@ -204,6 +230,31 @@ bool GCodeQueue::_enqueue(const char* cmd, bool say_ok/*=false*/
 
 #define ISEOL(C) ((C) == '\n' || (C) == '\r')
 
+#if ENABLED(RAPIDIA_SD_READ_AHEAD)
+
+  /**
+   * Return the offset of the first EOL in p[0..n), or n if there's none.
+   * Where words are wider than a byte, test a word of bytes at a time.
+   */
+  inline uint16_t find_eol(const char * const p, const uint16_t n) {
+    uint16_t i = 0;
+    #ifndef __AVR__
+      constexpr uint32_t ones = 0x01010101UL, highs = 0x80808080UL,
+                         lfs = ones * '\n', crs = ones * '\r';
+      for (; i + 4 <= n; i += 4) {
+        uint32_t w;
+        memcpy(&w, p + i, 4);
+        // (a byte of lf or cr is zero where w has that EOL.)
+        const uint32_t lf = w ^ lfs, cr = w ^ crs;
+        if (((lf - ones) & ~lf & highs) | ((cr - ones) & ~cr & highs)) break;
+      }
+    #endif
+    while (i < n && !ISEOL(p[i])) i++;
+    return i;
+  }
+
+#endif
+
 /**
  * Enqueue with Serial Echo
  * Return true if the command was consumed
@@ -332,6 +383,16 @@ void GCodeQueue::ok_to_send() {
     PORT_REDIRECT(pn);                    // Reply to the serial port that sent the command
   #endif
   if (!send_ok[index_r]) return;
+  #if ENABLED(RAPIDIA_BATCHED_OK)
+    if (ok_batching) {
+      const int16_t p = command_port();
+      if (ok_pending && p != ok_port) report_oks(-1, true);
+      if (!ok_pending++) ok_since = millis();
+      ok_port = p;
+      if (line[index_r] != -1) ok_line = line[index_r];
+      return;
+    }
+  #endif
   SERIAL_ECHOPGM(STR_OK);
   #if ENABLED(ADVANCED_OK)
     char* p = command_buffer[index_r];
@@ -347,11 +408,65 @@ void GCodeQueue::ok_to_send() {
   SERIAL_EOL();
 }
 
+#if ENABLED(RAPIDIA_BATCHED_OK)
+
+  /**
+   * Acknowledge the commands retired since the last ack, in one line:
+   *   ack:{"N":<last line>,"n":<commands>,"Q":<free queue slots>,"P":<free planner blocks>,"F":<finished line>}
+   * N is omitted if none of the commands had a line number, and F if there's no finished line.
+   * Unless forced (or there's a finished line to report), waits for a batch to build up.
+   */
+  void GCodeQueue::report_oks(const long finished_line/*=-1*/, const bool force/*=false*/) {
+    const bool finished = finished_line != -1;
+    if (!ok_pending && !finished) return;
+    if (!force && !finished && ok_pending < ok_batch_count && length && PENDING(millis(), ok_since + ok_batch_ms))
+      return;
+
+    #if HAS_MULTI_SERIAL
+      if (ok_pending) {
+        if (ok_port < 0) return;
+        PORT_REDIRECT(ok_port);
+      }
+    #endif
+
+    bool sep = true;
+    Rapidia::SerialLine out;
+    LINE_ECHOPGM(out, "ack:{");
+    if (ok_pending && ok_line != -1) {
+      out.echo_separator(sep);
+      out.echo_key('N');
+      out.echo_dec(ok_line);
+    }
+    out.echo_separator(sep);
+    out.echo_key('n');
+    out.echo_dec(ok_pending);
+    out.echo_separator(sep);
+    out.echo_key('Q');
+    out.echo_dec(BUFSIZE - length);
+    out.echo_separator(sep);
+    out.echo_key('P');
+    out.echo_dec(planner.moves_free());
+    if (finished) {
+      out.echo_separator(sep);
+      out.echo_key('F');
+      out.echo_dec(finished_line);
+    }
+    out.echo_char('}');
+    out.eol();
+
+    ok_pending = 0;
+    ok_line = -1;
+  }
+
+#endif // RAPIDIA_BATCHED_OK
+
 /**
  * Send a "Resend: nnn" message to the host to
  * indicate that a command needs to be re-sent.
  */
 void GCodeQueue::flush_and_request_resend() {
+  // (acknowledge what came before the resend request first.)
+  TERN_(RAPIDIA_BATCHED_OK, if (ok_batching) report_oks(-1, true));
   const int16_t pn = command_port();
   #if HAS_MULTI_SERIAL
     if (pn < 0) return;
@@ -360,6 +475,15 @@ void GCodeQueue::flush_and_request_resend() {
   SERIAL_FLUSH();
   SERIAL_ECHOPGM(STR_RESEND);
   SERIAL_ECHOLN(last_N[pn] + 1);
+  #if ENABLED(RAPIDIA_BATCHED_OK)
+    // (the rejected line's ack, right away and without an N.)
+    if (ok_batching) {
+      ok_pending++;
+      ok_port = pn;
+      report_oks(-1, true);
+      return;
+    }
+  #endif
   ok_to_send();
 }
 
@@ -377,6 +501,51 @@ inline int read_serial(const uint8_t index) {
   }
 }
 
+#if ENABLED(RAPIDIA_RX_STAGING)
+
+  /**
+   * Point span at the next received bytes and return how many there are.
+   * They stay in the RX buffer until serial_rx_consume releases them.
+   */
+  #ifdef HAL_SERIAL_RX_SPAN
+
+    inline uint16_t serial_rx_span(const uint8_t index, const uint8_t* &span) {
+      switch (index) {
+        case 0: return MYSERIAL0.rx_span(span);
+        #if HAS_MULTI_SERIAL
+          case 1: return MYSERIAL1.rx_span(span);
+        #endif
+        default: return 0;
+      }
+    }
+
+    inline void serial_rx_consume(const uint8_t index, const uint16_t n) {
+      switch (index) {
+        case 0: MYSERIAL0.rx_consume(n); break;
+        #if HAS_MULTI_SERIAL
+          case 1: MYSERIAL1.rx_consume(n); break;
+        #endif
+      }
+    }
+
+  #else
+
+    // (a byte at a time, where the HAL has no block reads.)
+    inline uint16_t serial_rx_span(const uint8_t index, const uint8_t* &span) {
+      static uint8_t c;
+      const int v = read_serial(index);
+      if (v < 0) return 0;
+      c = v;
+      span = &c;
+      return 1;
+    }
+
+    inline void serial_rx_consume(const uint8_t, const uint16_t) {}
+
+  #endif
+
+#endif // RAPIDIA_RX_STAGING
+
 void GCodeQueue::gcode_line_error(PGM_P const err, const int8_t pn, bool line_number) {
   PORT_REDIRECT(pn);                      // Reply to the serial port that sent the command
   SERIAL_ERROR_START();
@@ -400,6 +569,27 @@ FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", b
   return m29 && !NUMERIC(m29[3]);
 }
 
+/**
+ * The command word of a serial line, after any line number, read in one pass for the
+ * checks made on the line before it's queued. 'bare' if it's the whole line, as the
+ * critical commands are sent (without a line number or checksum).
+ */
+typedef struct { char letter; uint16_t codenum; bool bare; } serial_command_t;
+
+static serial_command_t serial_command(const char *cmd) {
+  serial_command_t sc = { '\0', 0, false };
+  const bool numbered = *cmd == 'N';
+  if (numbered) {
+    do cmd++; while (NUMERIC(*cmd));
+    while (*cmd == ' ') cmd++;
+  }
+  if (!*cmd || !NUMERIC(cmd[1])) return sc;
+  sc.letter = *cmd++;
+  do sc.codenum = sc.codenum * 10 + (*cmd++ - '0'); while (NUMERIC(*cmd) && sc.codenum < 1000);
+  sc.bare = !numbered && !*cmd;
+  return sc;
+}
+
 #define PS_NORMAL 0
 #define PS_EOL    1
 #define PS_QUOTED 2
@@ -480,6 +670,8 @@ void GCodeQueue::get_serial_commands() {
 
   static uint8_t serial_input_state[NUM_SERIAL] = { PS_NORMAL };
 
+  TERN_(RAPIDIA_RX_STAGING, commit_staged());
+
   #if ENABLED(BINARY_FILE_TRANSFER)
     if (card.flag.binary_mode) {
       /**
@@ -492,6 +684,14 @@ void GCodeQueue::get_serial_commands() {
     }
   #endif
 
+  #if ENABLED(RAPIDIA_BINARY_MOTION)
+    // (R760) frames of moves rather than lines of gcode.
+    if (Rapidia::binary_motion.active()) {
+      Rapidia::binary_motion.receive();
+      return;
+    }
+  #endif
+
   // If the command buffer is empty for too long,
   // send "wait" to indicate Marlin is still waiting.
   #if NO_TIMEOUTS > 0
@@ -504,15 +704,39 @@ void GCodeQueue::get_serial_commands() {
   #endif
 
   /**
-   * Loop while serial characters are incoming and the queue is not full
+   * Loop while serial characters are incoming and the queue
+   * (or with RAPIDIA_RX_STAGING, the staging lines) is not full
    */
-  while (length < BUFSIZE && serial_data_available()) {
+  #if ENABLED(RAPIDIA_RX_STAGING)
+    #define STAGING_FULL (staged_count >= RAPIDIA_RX_STAGING_LINES)
+  #else
+    #define STAGING_FULL (length >= BUFSIZE)
+  #endif
+  while (!STAGING_FULL && serial_data_available()) {
     LOOP_L_N(i, NUM_SERIAL) {
 
-      const int c = read_serial(i);
-      if (c < 0) continue;
+      #if ENABLED(RAPIDIA_RX_STAGING)
+        if (STAGING_FULL) break;
+
+        // Decode the line straight out of the RX buffer, up to its end of line.
+        const uint8_t *span;
+        const uint16_t n = serial_rx_span(i, span);
+        uint16_t used = 0;
+        while (used < n && !ISEOL(span[used]))
+          process_stream_char(span[used++], serial_input_state[i], serial_line_buffer[i], serial_count[i]);
+        if (used == n) {
+          serial_rx_consume(i, used);
+          continue;
+        }
+        // (released before the line is processed: an error clears the RX buffer.)
+        serial_rx_consume(i, used + 1);
+        const char serial_char = '\n';
+      #else
+        const int c = read_serial(i);
+        if (c < 0) continue;
 
-      const char serial_char = c;
+        const char serial_char = c;
+      #endif
 
       if (ISEOL(serial_char)) {
 
@@ -525,13 +749,16 @@ void GCodeQueue::get_serial_commands() {
         while (*command == ' ') command++;                   // Skip leading spaces
         char *npos = (*command == 'N') ? command : nullptr;  // Require the N parameter to start the line
 
-        // calculate checksum and compare
+        // calculate checksum
         char *apos = strrchr(command, '*');
 
+        const serial_command_t sc = serial_command(command);
+        #define IS_CODE(L,N) (sc.letter == L && sc.codenum == N)
+
         // R732 and M110 are 'meta commands' which relate to error checking,
         // so they are themselves exempt from certain error checking.
-        #define is_R732 (strstr_P(command, PSTR("R732")) != nullptr)
-        #define is_M110 (strstr_P(command, PSTR("M110")) != nullptr)
+        #define is_R732 IS_CODE('R', 732)
+        #define is_M110 IS_CODE('M', 110)
 
         if (apos) {
           #if ENABLED(RAPIDIA_CHECKSUMS)
@@ -574,7 +801,7 @@ void GCodeQueue::get_serial_commands() {
             if (n2pos) npos = n2pos;
           }
 
-          const long gcode_N = strtol(npos + 1, nullptr, 10);
+          gcode_N = strtol(npos + 1, nullptr, 10);
 
           if (gcode_N != last_N[i] + 1 && !M110)
             return gcode_line_error(PSTR(STR_ERR_LINE_NO), i);
@@ -583,7 +810,7 @@ void GCodeQueue::get_serial_commands() {
         }
         #if ENABLED(SDSUPPORT)
           // Pronterface "M29" and "M29 " has no line number
-          else if (card.flag.saving && !is_M29(command))
+          else if (card.flag.saving && !IS_CODE('M', 29))
             return gcode_line_error(PSTR(STR_ERR_NO_CHECKSUM), i);
         #endif
 
@@ -591,62 +818,101 @@ void GCodeQueue::get_serial_commands() {
         // Movement commands give an alert when the machine is stopped
         //
 
-        if (IsStopped()) {
-          char* gpos = strchr(command, 'G');
-          if (gpos) {
-            switch (strtol(gpos + 1, nullptr, 10)) {
-              case 0: case 1:
-              #if ENABLED(ARC_SUPPORT)
-                case 2: case 3:
-              #endif
-              #if ENABLED(BEZIER_CURVE_SUPPORT)
-                case 5:
-              #endif
-                PORT_REDIRECT(i);                      // Reply to the serial port that sent the command
-                SERIAL_ECHOLNPGM(STR_ERR_STOPPED);
-                LCD_MESSAGEPGM(MSG_STOPPED);
-                break;
-            }
+        if (IsStopped() && sc.letter == 'G') {
+          switch (sc.codenum) {
+            case 0: case 1:
+            #if ENABLED(ARC_SUPPORT)
+              case 2: case 3:
+            #endif
+            #if ENABLED(BEZIER_CURVE_SUPPORT)
+              case 5:
+            #endif
+              PORT_REDIRECT(i);                      // Reply to the serial port that sent the command
+              SERIAL_ECHOLNPGM(STR_ERR_STOPPED);
+              LCD_MESSAGEPGM(MSG_STOPPED);
+              break;
           }
         }
 
         #if DISABLED(EMERGENCY_PARSER)
           // Process critical commands early
-          if (strcmp_P(command, PSTR("M108")) == 0) {
-            wait_for_heatup = false;
-            TERN_(HAS_LCD_MENU, wait_for_user = false);
+          if (sc.bare) {
+            if (IS_CODE('M', 108)) {
+              wait_for_heatup = false;
+              TERN_(HAS_LCD_MENU, wait_for_user = false);
+            }
+            else if (IS_CODE('M', 112)) kill(M112_KILL_STR, nullptr, true);
+            else if (IS_CODE('M', 410)) quickstop_stepper();
+            else if (IS_CODE('R', 751) || TERN0(RAPIDIA_M_CODE_COMPATABILITY, IS_CODE('M', 751))) { Rapidia::pause.pause(false); continue; }
+            else if (IS_CODE('R', 752) || TERN0(RAPIDIA_M_CODE_COMPATABILITY, IS_CODE('M', 752))) { Rapidia::pause.pause(true); continue; }
           }
-          if (strcmp_P(command, PSTR("M112")) == 0) kill(M112_KILL_STR, nullptr, true);
-          if (strcmp_P(command, PSTR("M410")) == 0) quickstop_stepper();
-          else if (strcmp_P(command, PSTR("R751")) == 0) { Rapidia::pause.pause(false); continue; }
-          else if (strcmp_P(command, PSTR("R752")) == 0) { Rapidia::pause.pause(true); continue; }
-          #if ENABLED(RAPIDIA_M_CODE_COMPATABILITY)
-          else if (strcmp_P(command, PSTR("M751")) == 0) { Rapidia::pause.pause(false); continue; }
-          else if (strcmp_P(command, PSTR("M752")) == 0) { Rapidia::pause.pause(true); continue; }
-          #endif
         #endif
 
         #if defined(NO_TIMEOUTS) && NO_TIMEOUTS > 0
           last_command_time = ms;
         #endif
 
-        // Add the command to the queue
-        _enqueue(serial_line_buffer[i], true
-          #if HAS_MULTI_SERIAL
-            , i
-          #endif
-          #if ENABLED(RAPIDIA_BLOCK_SOURCE)
-            , gcode_N
-          #endif
-        );
+        #if ENABLED(RAPIDIA_RX_STAGING)
+
+          // Add the command to the staging lines, and on to the queue if there's room
+          staged_t &stage = staged[(staged_r + staged_count) % RAPIDIA_RX_STAGING_LINES];
+          strcpy(stage.command, serial_line_buffer[i]);
+          TERN_(HAS_MULTI_SERIAL, stage.port = i);
+          TERN_(RAPIDIA_BLOCK_SOURCE, stage.line = gcode_N);
+          staged_count++;
+          commit_staged();
+
+        #else
+
+          // Add the command to the queue
+          _enqueue(serial_line_buffer[i], true
+            #if HAS_MULTI_SERIAL
+              , i
+            #endif
+            #if ENABLED(RAPIDIA_BLOCK_SOURCE)
+              , gcode_N
+            #endif
+          );
+
+        #endif
+
+        #undef is_R732
+        #undef is_M110
+        #undef IS_CODE
       }
       else
         process_stream_char(serial_char, serial_input_state[i], serial_line_buffer[i], serial_count[i]);
 
     } // for NUM_SERIAL
   } // queue has space, serial has data
+
+  #undef STAGING_FULL
 }
 
+#if ENABLED(RAPIDIA_RX_STAGING)
+
+  /**
+   * Move staged serial lines into the queue, oldest first, while there's room.
+   */
+  void GCodeQueue::commit_staged() {
+    while (staged_count && length < BUFSIZE) {
+      const staged_t &stage = staged[staged_r];
+      strcpy(command_buffer[index_w], stage.command);
+      _commit_command(true
+        #if HAS_MULTI_SERIAL
+          , stage.port
+        #endif
+        #if ENABLED(RAPIDIA_BLOCK_SOURCE)
+          , stage.line
+        #endif
+      );
+      if (++staged_r >= RAPIDIA_RX_STAGING_LINES) staged_r = 0;
+      staged_count--;
+    }
+  }
+
+#endif
+
 #if ENABLED(SDSUPPORT)
 
   /**
@@ -661,6 +927,36 @@ void GCodeQueue::get_serial_commands() {
     if (!IS_SD_PRINTING()) return;
 
     int sd_count = 0;
+
+    #if ENABLED(RAPIDIA_SD_READ_AHEAD)
+
+      while (length < BUFSIZE) {
+        const char *p;
+        const int16_t n = card.read_span(p);
+        if (n < 0) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
+
+        // Scan the buffered bytes up to the end of the line (or file)
+        const uint16_t e = find_eol(p, n);
+        for (uint16_t i = 0; i < e; i++) process_stream_char(p[i], sd_input_state, command_buffer[index_w], sd_count);
+        const bool card_eof = e == n && card.eof();
+        if (e < n) card.consume(e + 1);     // (through the EOL)
+        else if (n) { card.consume(n); continue; }
+
+        // Reset stream state, terminate the buffer, and commit a non-empty command
+        if (!process_line_done(sd_input_state, command_buffer[index_w], sd_count)) {
+          _commit_command(false);
+          #if ENABLED(POWER_LOSS_RECOVERY)
+            recovery.cmd_sdpos = card.getIndex();     // Prime for the NEXT _commit_command (the start of the next line)
+          #endif
+        }
+
+        if (card_eof) { card.fileHasFinished(); break; } // Handle end of file reached
+      }
+
+      return;
+
+    #endif
+
     bool card_eof = card.eof();
     while (length < BUFSIZE && !card_eof) {
       const int16_t n = card.get();
@@ -712,7 +1008,11 @@ void GCodeQueue::advance() {
   if (process_injected_command_P() || process_injected_command()) return;
 
   // Return if the G-code buffer is empty
-  if (!length) return;
+  // (binary motion frames are planned once the commands ahead of them have run.)
+  if (!length) {
+    TERN_(RAPIDIA_BINARY_MOTION, Rapidia::binary_motion.advance());
+    return;
+  }
 
   #if ENABLED(SDSUPPORT)
 
@@ -64,6 +64,26 @@ public:
     static long line[BUFSIZE];
   #endif
 
+  /**
+   * Serial lines which have been received and checked (checksum, line number),
+   * waiting for a free queue slot. Serial input is read into these even while the
+   * queue is full, so the RX buffer keeps draining while the planner is busy.
+   */
+  #if ENABLED(RAPIDIA_RX_STAGING)
+    struct staged_t {
+      char command[MAX_CMD_SIZE];
+      #if HAS_MULTI_SERIAL
+        int16_t port;
+      #endif
+      #if ENABLED(RAPIDIA_BLOCK_SOURCE)
+        long line;
+      #endif
+    };
+    static staged_t staged[RAPIDIA_RX_STAGING_LINES];
+    static uint8_t staged_r,      // Oldest staged line
+                   staged_count;  // Number of staged lines
+  #endif
+
   static int16_t command_port() {
     return TERN0(HAS_MULTI_SERIAL, port[index_r]);
   }
@@ -161,6 +181,19 @@ public:
    */
   static void ok_to_send();
 
+  #if ENABLED(RAPIDIA_BATCHED_OK)
+    /**
+     * Batched acknowledgements (R761). ok_to_send only counts commands, and
+     * report_oks (from idle) acknowledges them together in one "ack:{...}" line,
+     * along with the last finished line (R730), if any.
+     */
+    static bool ok_batching;
+    static uint8_t ok_batch_count;  // Acknowledge once this many commands are pending,
+    static uint16_t ok_batch_ms;    // or once the oldest has waited this long (ms)
+
+    static void report_oks(const long finished_line=-1, const bool force=false);
+  #endif
+
   /**
    * Clear the serial line and request a resend of
    * the next expected line number.
@@ -173,6 +206,10 @@ private:
 
   static void get_serial_commands();
 
+  #if ENABLED(RAPIDIA_RX_STAGING)
+    static void commit_staged();
+  #endif
+
   #if ENABLED(SDSUPPORT)
     static void get_sdcard_commands();
   #endif
@@ -52,28 +52,6 @@ static void set_checksum_mode(checksum_mode_t& checksum_mode)
     }
 }
 
-static void echo_checksum_name(checksum_mode_t c)
-{
-  switch(c)
-  {
-  case CHECKSUMS_DISABLED:
-    SERIAL_ECHO("disabled");
-    return;
-  case CHECKSUMS_XOR:
-    SERIAL_ECHO("xor");
-    return;
-  case CHECKSUMS_XOR_OPTIONAL:
-    SERIAL_ECHO("xor (optional)");
-    return;
-  case CHECKSUMS_CRC16:
-    SERIAL_ECHO("crc16/XMODEM");
-    return;
-  default:
-    SERIAL_ECHO("unknown");
-    return;
-  }
-}
-
 void GcodeSuite::R732()
 {
   if (parser.seenval('I'))
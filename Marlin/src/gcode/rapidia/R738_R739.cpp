@@ -109,23 +109,50 @@ static void parse_heartbeat_select(HeartbeatSelectionUint& io_heartbeat_select)
   }
 }
 
+static void parse_heartbeat_encoding(HeartbeatEncoding& io_encoding)
+{
+  if (parser.seen('B'))
+  {
+    io_encoding = parser.value_bool()
+      ? HeartbeatEncoding::BINARY
+      : HeartbeatEncoding::TEXT;
+  }
+}
+
 void GcodeSuite::R738()
 {
+  if (parser.seenval('K'))
+  {
+    heartbeat.set_keyframe_interval(parser.value_ushort());
+  }
+
   if (parser.seenval('H'))
   {
     uint16_t interval = parser.value_ushort();
     heartbeat.set_interval(interval);
   }
 
+  parse_heartbeat_encoding(heartbeat.encoding);
   parse_heartbeat_select(heartbeat.selection);
 }
 
 void GcodeSuite::R739()
 {
   HeartbeatSelectionUint selection = heartbeat.selection;
+  HeartbeatEncoding encoding = heartbeat.encoding;
 
+  parse_heartbeat_encoding(encoding);
   parse_heartbeat_select(selection);
-  heartbeat.serial_info(selection);
+  heartbeat.serial_info(selection, encoding);
+
+  // report frame size
+  if (parser.seen('S'))
+  {
+    SERIAL_ECHO_START();
+    SERIAL_ECHOPGM("Heartbeat frame (");
+    serialprintPGM(encoding == HeartbeatEncoding::BINARY ? PSTR("binary") : PSTR("text"));
+    SERIAL_ECHOLNPAIR("): ", heartbeat.last_frame_bytes, " bytes");
+  }
 }
 
 #endif // ENABLED(RAPIDIA_HEARTBEAT)
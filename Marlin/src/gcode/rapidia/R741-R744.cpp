@@ -84,6 +84,8 @@ void GcodeSuite::R744()
         data.e_mm[extruder - 1] = Rapidia::u64nm_to_mileage(amount_nm);
     }
 
+    mileage.mark_dirty();
+
     if (save && mileage.save_eeprom())
     {
         SERIAL_ERROR_MSG("Mileage was not saved to EEPROM.");
@@ -0,0 +1,29 @@
+#include "../../inc/MarlinConfig.h"
+
+#include "../gcode.h"
+#include "../../feature/rapidia/mileage.h"
+
+#if ENABLED(RAPIDIA_MILEAGE)
+
+using namespace Rapidia;
+
+// report mileage EEPROM journal state and remaining write budget
+void GcodeSuite::R747()
+{
+    // (make sure the journal has been scanned.)
+    mileage.data();
+
+    const uint32_t budget = mileage.get_write_budget();
+
+    SERIAL_ECHO_START();
+    SERIAL_ECHOPAIR("Mileage journal: saves:", mileage.get_sequence());
+    SERIAL_ECHOPAIR(" slot:", mileage.get_save_index());
+    SERIAL_ECHOPAIR(" usable:", mileage.get_usable_slots());
+    SERIAL_CHAR('/');
+    SERIAL_ECHO(RAPIDIA_MILEAGE_SAVE_MULTIPLICITY);
+    SERIAL_ECHOPAIR(" remaining:", budget);
+    SERIAL_ECHOPAIR(" days:", float(budget) * (mileage.save_interval_ms / 1000.0f) / 86400.0f);
+    SERIAL_EOL();
+}
+
+#endif // RAPIDIA_MILEAGE
@@ -0,0 +1,18 @@
+#include "../../inc/MarlinConfig.h"
+
+#include "../gcode.h"
+#include "../../feature/rapidia/task_profiler.h"
+
+#if ENABLED(RAPIDIA_TASK_PROFILER)
+
+using namespace Rapidia;
+
+// report main loop task timing
+// R: reset after reporting
+void GcodeSuite::R748()
+{
+    TaskProfiler::report();
+    if (parser.seen('R')) TaskProfiler::reset();
+}
+
+#endif // RAPIDIA_TASK_PROFILER
@@ -0,0 +1,14 @@
+#include "../../inc/MarlinConfig.h"
+
+#include "../gcode.h"
+#include "../../feature/rapidia/pause.h"
+
+#if ENABLED(RAPIDIA_PAUSE_RESUME)
+
+// resume the last pause, without the host re-sending the gcode it interrupted.
+void GcodeSuite::R754()
+{
+    Rapidia::pause.resume();
+}
+
+#endif // RAPIDIA_PAUSE_RESUME
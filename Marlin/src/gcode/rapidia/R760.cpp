@@ -0,0 +1,29 @@
+#include "../../inc/MarlinConfig.h"
+
+#include "../gcode.h"
+#include "../queue.h"
+#include "../../feature/rapidia/binary_motion.h"
+#include "../../feature/rapidia/serial_line.h"
+
+#if ENABLED(RAPIDIA_BINARY_MOTION)
+
+using namespace Rapidia;
+
+// switch this serial port to binary motion frames, until an end frame.
+// (the host should wait for this command's ok before sending frames.)
+void GcodeSuite::R760()
+{
+    binary_motion.start(queue.command_port());
+
+    SerialLine line;
+    LINE_ECHOPGM(line, "bm:{");
+    LINE_ECHO_KEY_STR(line, "frame");
+    line.echo_dec(RAPIDIA_BINARY_MOTION_FRAME_SIZE);
+    line.echo_char(',');
+    LINE_ECHO_KEY_STR(line, "fixed");
+    line.echo_dec(BINARY_MOTION_FIXED_POINT);
+    line.echo_char('}');
+    line.eol();
+}
+
+#endif // RAPIDIA_BINARY_MOTION
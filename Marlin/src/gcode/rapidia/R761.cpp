@@ -0,0 +1,41 @@
+#include "../../inc/MarlinConfig.h"
+
+#include "../gcode.h"
+#include "../queue.h"
+#include "../../feature/rapidia/serial_line.h"
+
+#if ENABLED(RAPIDIA_BATCHED_OK)
+
+using namespace Rapidia;
+
+// batched acknowledgements: S1 enables, S0 disables,
+// B: acknowledge once this many commands are pending, T: or once the oldest has waited this long (ms).
+void GcodeSuite::R761()
+{
+    if (parser.seenval('B')) queue.ok_batch_count = constrain(parser.value_byte(), 1, BUFSIZE);
+    if (parser.seenval('T')) queue.ok_batch_ms = parser.value_ushort();
+    if (parser.seenval('S'))
+    {
+        // (acks pending from before are sent the old way.)
+        if (queue.ok_batching) queue.report_oks(-1, true);
+        queue.ok_batching = parser.value_bool();
+    }
+
+    SerialLine line;
+    LINE_ECHOPGM(line, "ack:{");
+    LINE_ECHO_KEY_STR(line, "on");
+    line.echo_dec(queue.ok_batching);
+    line.echo_char(',');
+    LINE_ECHO_KEY_STR(line, "rx");
+    line.echo_dec(RX_BUFFER_SIZE - 1);
+    line.echo_char(',');
+    line.echo_key('B');
+    line.echo_dec(queue.ok_batch_count);
+    line.echo_char(',');
+    line.echo_key('T');
+    line.echo_dec(queue.ok_batch_ms);
+    line.echo_char('}');
+    line.eol();
+}
+
+#endif // RAPIDIA_BATCHED_OK
@@ -0,0 +1,33 @@
+#include "../../inc/MarlinConfig.h"
+
+#include "../gcode.h"
+#include "../../module/motion.h"
+#include "../../module/planner.h"
+
+#if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+
+// move the idle X carriage (full control mode only), alongside the active one's moves.
+// X: position, F: feedrate (mm/min, default the X max feedrate).
+// X is limited to RAPIDIA_CARRIAGE_INTERVAL clear of where the active carriage is headed.
+void GcodeSuite::R762()
+{
+    if (dual_x_carriage_mode != DXC_FULL_CONTROL_MODE)
+    {
+        SERIAL_ERROR_MSG("R762 requires full control mode (M605 S0)");
+        return;
+    }
+    if (!parser.seenval('X') || homing_needed_error(_BV(X_AXIS))) return;
+
+    const float x = LOGICAL_TO_NATIVE(parser.value_linear_units(), X_AXIS);
+    const feedRate_t fr_mm_s = parser.seenval('F') ? parser.value_feedrate() : planner.settings.max_feedrate_mm_s[X_AXIS];
+
+    reset_stepper_timeout();
+    const float to = idle_carriage_move_to(x, fr_mm_s);
+    if (to != x)
+    {
+        SERIAL_ECHO_START();
+        SERIAL_ECHOLNPAIR("R762 X limited to ", NATIVE_TO_LOGICAL(to, X_AXIS));
+    }
+}
+
+#endif // RAPIDIA_IDLE_CARRIAGE
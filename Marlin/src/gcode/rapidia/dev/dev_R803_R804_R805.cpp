@@ -1,6 +1,7 @@
 #include "../../../inc/MarlinConfig.h"
 #include "../../gcode.h"
 #include "../../../feature/rapidia/checksum.h"
+#include "../../../feature/rapidia/serial_line.h"
 #include "../../../HAL/shared/eeprom_api.h"
 #include "../../../MarlinCore.h"
 #include "../../../HAL/HAL.h"
@@ -13,8 +14,6 @@
 // read EEPROM
 void GcodeSuite::R803()
 {
-    SERIAL_INIT_CHECKSUM();
-
     uint16_t length = 1;
     if (parser.seenval('L'))
     {
@@ -32,35 +31,36 @@ void GcodeSuite::R803()
         uint16_t end = ((disp_end + ROW_WIDTH - 1) / ROW_WIDTH) * ROW_WIDTH;
         end = min(end, E2END + 1);
 
+        Rapidia::SerialLine line;
         for (uint16_t i = start; i < end; ++i)
         {
             if (i % ROW_WIDTH == 0)
             {
                 // row header
-                SERIAL_ECHOPGM_CHK("EEPROM ");
-                serial_hex_chk(CHK_ARGS i, 3);
-                SERIAL_ECHOPGM_CHK(":");
+                LINE_ECHOPGM(line, "EEPROM ");
+                line.echo_hex(i, 3);
+                line.echo_char(':');
             }
 
-            SERIAL_CHAR_CHK(' ');
+            line.echo_char(' ');
 
             if (i >= disp_start && i < disp_end)
             {
                 // display hex value of 
                 uint8_t v;
                 persistentStore.read(i, v);
-                serial_hex_chk(CHK_ARGS v, 2);
+                line.echo_hex(v, 2);
             }
             else
             {
                 // display two dots
-                SERIAL_CHAR_CHK('.');
-                SERIAL_CHAR_CHK('.');
+                line.echo_char('.');
+                line.echo_char('.');
             }
             
             if (i % ROW_WIDTH == ROW_WIDTH - 1)
             {
-                SERIAL_EOL_CHK();
+                line.eol();
             }
         }
     }
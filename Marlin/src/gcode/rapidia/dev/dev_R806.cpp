@@ -0,0 +1,57 @@
+#include "../../../inc/MarlinConfig.h"
+#include "../../gcode.h"
+#include "../../../feature/rapidia/checksum.h"
+
+#if ENABLED(RAPIDIA_DEV) && ENABLED(RAPIDIA_CHECKSUMS)
+
+using namespace Rapidia;
+
+#define BENCHMARK_BUFFER_SIZE 64
+
+// checksum benchmark.
+// R<u16>: number of passes over the buffer (default 64)
+// reports cycles per byte for each checksum mode.
+// (interrupts remain enabled, so stepper/temperature isr time is included.)
+void GcodeSuite::R806()
+{
+    uint16_t passes = 64;
+    if (parser.seenval('R'))
+    {
+        passes = _MAX(parser.value_ushort(), 1);
+    }
+
+    // printable data, like an outgoing line.
+    char buff[BENCHMARK_BUFFER_SIZE];
+    for (uint8_t i = 0; i < BENCHMARK_BUFFER_SIZE; ++i)
+    {
+        buff[i] = ' ' + (i * 7) % ('~' - ' ');
+    }
+
+    const uint32_t bytes = uint32_t(passes) * BENCHMARK_BUFFER_SIZE;
+
+    SERIAL_ECHO_START();
+    SERIAL_ECHOLNPAIR("checksum benchmark: ", bytes, " bytes");
+
+    for (uint8_t m = CHECKSUMS_DISABLED; m <= CHECKSUMS_CRC16; ++m)
+    {
+        const checksum_mode_t mode = static_cast<checksum_mode_t>(m);
+        checksum_t c = 0;
+
+        const uint32_t start_us = micros();
+        for (uint16_t i = 0; i < passes; ++i)
+        {
+            checksum(c, buff, BENCHMARK_BUFFER_SIZE, mode);
+        }
+        const uint32_t elapsed_us = micros() - start_us;
+
+        SERIAL_ECHO_START();
+        SERIAL_ECHO(int(m));
+        SERIAL_ECHOPGM(" (");
+        echo_checksum_name(mode);
+        SERIAL_ECHOPAIR("): ", elapsed_us, " us, cycles/byte: ");
+        SERIAL_ECHO(float(elapsed_us) * (F_CPU / 1000000UL) / bytes);
+        SERIAL_ECHOLNPAIR(" (result ", c, ")");
+    }
+}
+
+#endif // RAPIDIA_DEV
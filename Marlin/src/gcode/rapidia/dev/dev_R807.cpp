@@ -0,0 +1,51 @@
+#include "../../../inc/MarlinConfig.h"
+#include "../../gcode.h"
+#include "../../../feature/rapidia/isr_profiler.h"
+
+#if ENABLED(RAPIDIA_DEV) && ENABLED(RAPIDIA_ISR_PROFILER)
+
+using namespace Rapidia;
+
+static void echo_phase(PGM_P name, const IsrPhaseStats& s)
+{
+    SERIAL_ECHO_START();
+    serialprintPGM(name);
+    SERIAL_ECHOPAIR(" n:", s.count);
+    if (s.count)
+    {
+        SERIAL_ECHOPAIR(" min:", s.min, " max:", s.max, " mean:");
+        SERIAL_ECHO(float(s.sum) / s.count);
+    }
+    SERIAL_ECHOPGM(" hist:");
+    for (uint8_t i = 0; i < ISR_HISTOGRAM_BUCKETS; ++i)
+    {
+        if (i) SERIAL_CHAR(',');
+        SERIAL_ECHO(s.histogram[i]);
+    }
+    SERIAL_EOL();
+}
+
+// stepper ISR profile.
+// R: reset the counters after reporting.
+// times are in stepper timer ticks.
+void GcodeSuite::R807()
+{
+    IsrPhaseStats stats[ISR_PHASE_COUNT];
+    uint32_t overruns, loop_limits;
+    IsrProfiler::snapshot(stats, overruns, loop_limits);
+    if (parser.seen('R')) IsrProfiler::reset();
+
+    SERIAL_ECHO_START();
+    SERIAL_ECHOLNPAIR("stepper isr profile, ticks/us:", int(STEPPER_TIMER_TICKS_PER_US));
+    echo_phase(PSTR("pulse"), stats[ISR_PHASE_PULSE]);
+    #if ENABLED(LIN_ADVANCE)
+        echo_phase(PSTR("advance"), stats[ISR_PHASE_ADVANCE]);
+    #endif
+    echo_phase(PSTR("block"), stats[ISR_PHASE_BLOCK]);
+    echo_phase(PSTR("isr"), stats[ISR_PHASE_TOTAL]);
+
+    SERIAL_ECHO_START();
+    SERIAL_ECHOLNPAIR("overruns:", overruns, " loop limit:", loop_limits);
+}
+
+#endif // RAPIDIA_DEV
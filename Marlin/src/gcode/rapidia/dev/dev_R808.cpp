@@ -0,0 +1,43 @@
+#include "../../../inc/MarlinConfig.h"
+#include "../../gcode.h"
+#include "../../../module/planner.h"
+
+#if ENABLED(RAPIDIA_DEV) && ENABLED(RAPIDIA_REPLAN_STATS)
+
+static void echo_mean(PGM_P key, const uint32_t total, const uint32_t count)
+{
+    serialprintPGM(key);
+    SERIAL_ECHO(count ? float(total) / count : 0.0f);
+}
+
+// planner replan profile: work done by Planner::recalculate() per new block.
+// S: incremental replanning on (1) or off (0). (RAPIDIA_INCREMENTAL_REPLAN)
+// R: reset the counters after reporting.
+void GcodeSuite::R808()
+{
+    #if ENABLED(RAPIDIA_INCREMENTAL_REPLAN)
+        if (parser.seenval('S')) planner.incremental_replan = parser.value_bool();
+    #endif
+
+    const Planner::replan_stats_t s = planner.replan_stats;
+    if (parser.seen('R')) planner.replan_stats = {};
+
+    SERIAL_ECHO_START();
+    SERIAL_ECHOPAIR("replan inserts:", s.inserts, " incremental:", int(TERN0(RAPIDIA_INCREMENTAL_REPLAN, planner.incremental_replan)));
+    SERIAL_ECHOLNPAIR(" blocks:", int(BLOCK_BUFFER_SIZE));
+
+    // blocks visited per insert, by pass.
+    SERIAL_ECHO_START();
+    echo_mean(PSTR("visited reverse:"), s.reverse, s.inserts);
+    echo_mean(PSTR(" forward:"), s.forward, s.inserts);
+    echo_mean(PSTR(" trapezoid:"), s.trapezoid, s.inserts);
+    echo_mean(PSTR(" total:"), s.reverse + s.forward + s.trapezoid, s.inserts);
+    SERIAL_ECHOLNPAIR(" max:", s.visited_max);
+
+    SERIAL_ECHO_START();
+    echo_mean(PSTR("recalculated:"), s.recalculated, s.inserts);
+    echo_mean(PSTR(" us:"), s.us, s.inserts);
+    SERIAL_ECHOLNPAIR(" max:", s.us_max);
+}
+
+#endif // RAPIDIA_DEV
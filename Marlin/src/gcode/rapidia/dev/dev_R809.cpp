@@ -0,0 +1,23 @@
+#include "../../../inc/MarlinConfig.h"
+#include "../../gcode.h"
+#include "../../../module/motion.h"
+
+#if ENABLED(RAPIDIA_DEV) && ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+
+// leveled move segments: planner segments per leveled XY move.
+// S: split per grid cell to the tolerance (1) or into LEVELED_SEGMENT_LENGTH pieces (0).
+// R: reset the counters after reporting.
+void GcodeSuite::R809()
+{
+    if (parser.seenval('S')) adaptive_leveled_segments = parser.value_bool();
+
+    const leveled_segment_stats_t s = leveled_segment_stats;
+    if (parser.seen('R')) leveled_segment_stats = {};
+
+    SERIAL_ECHO_START();
+    SERIAL_ECHOPAIR("leveled moves:", s.moves, " segments:", s.segments, " per move:");
+    SERIAL_ECHO(s.moves ? float(s.segments) / s.moves : 0.0f);
+    SERIAL_ECHOLNPAIR(" adaptive:", int(adaptive_leveled_segments));
+}
+
+#endif // RAPIDIA_DEV
@@ -21,6 +21,7 @@
  */
 
 #include "../gcode.h"
+#include "../queue.h"
 #include "../../module/temperature.h"
 
 /**
@@ -31,6 +32,10 @@ void GcodeSuite::M105() {
   const int8_t target_extruder = get_target_extruder_from_command();
   if (target_extruder < 0) return;
 
+  // (batched, the "ok" goes out with the next ack line, and the report starts with " T:".)
+  #if ENABLED(RAPIDIA_BATCHED_OK)
+    if (queue.ok_batching) queue.ok_to_send(); else
+  #endif
   SERIAL_ECHOPGM(STR_OK);
 
   #if HAS_TEMP_SENSOR
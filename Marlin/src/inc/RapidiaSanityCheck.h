@@ -27,5 +27,109 @@
 #endif
 
 #if ENABLED(RAPIDIA_STACK_USAGE) && !ENABLED(RAPIDIA_STACK_UTIL)
-    #error RAPIDIA_STACK_USAGE requires RAPIDIA_STACK_UTIL
-#endif
\ No newline at end of file
+  #error RAPIDIA_STACK_USAGE requires RAPIDIA_STACK_UTIL
+#endif
+#if ENABLED(RAPIDIA_ISR_PROFILER) && DISABLED(RAPIDIA_DEV)
+  #error "RAPIDIA_ISR_PROFILER requires RAPIDIA_DEV (R807)"
+#endif
+
+#if defined(RAPIDIA_ARC_CHORD_TOLERANCE) && !defined(RAPIDIA_ARC_MAX_SEGMENT_MM)
+  #error "RAPIDIA_ARC_CHORD_TOLERANCE requires RAPIDIA_ARC_MAX_SEGMENT_MM"
+#endif
+
+#if ENABLED(RAPIDIA_BINARY_MOTION)
+  #if DISABLED(RAPIDIA_CHECKSUMS)
+    #error "RAPIDIA_BINARY_MOTION requires RAPIDIA_CHECKSUMS"
+  #elif !defined(RAPIDIA_BINARY_MOTION_FRAME_SIZE) || !WITHIN(RAPIDIA_BINARY_MOTION_FRAME_SIZE, 16, 254)
+    #error "RAPIDIA_BINARY_MOTION_FRAME_SIZE must be between 16 and 254"
+  #endif
+#endif
+
+#if ENABLED(RAPIDIA_BATCHED_OK)
+  #if DISABLED(RAPIDIA_LINE_AUTO_REPORTING)
+    #error "RAPIDIA_BATCHED_OK requires RAPIDIA_LINE_AUTO_REPORTING"
+  #elif !WITHIN(RAPIDIA_BATCHED_OK_COUNT, 1, BUFSIZE)
+    #error "RAPIDIA_BATCHED_OK_COUNT must be between 1 and BUFSIZE"
+  #endif
+#endif
+
+#if ENABLED(RAPIDIA_RX_STAGING) && !WITHIN(RAPIDIA_RX_STAGING_LINES, 1, 16)
+  #error "RAPIDIA_RX_STAGING_LINES must be between 1 and 16"
+#endif
+
+#if ENABLED(RAPIDIA_SD_READ_AHEAD)
+  #if DISABLED(SDSUPPORT)
+    #error "RAPIDIA_SD_READ_AHEAD requires SDSUPPORT"
+  #elif !WITHIN(RAPIDIA_SD_READ_AHEAD_SIZE, 32, 1024)
+    #error "RAPIDIA_SD_READ_AHEAD_SIZE must be between 32 and 1024"
+  #endif
+#endif
+
+#if ENABLED(RAPIDIA_REPLAN_STATS) && DISABLED(RAPIDIA_DEV)
+  #error "RAPIDIA_REPLAN_STATS requires RAPIDIA_DEV (R808)"
+#endif
+
+#if ENABLED(RAPIDIA_STEPPER_PAUSE)
+  #if DISABLED(RAPIDIA_PAUSE)
+    #error "RAPIDIA_STEPPER_PAUSE requires RAPIDIA_PAUSE"
+  #elif ANY(S_CURVE_ACCELERATION, DIRECT_STEPPING)
+    #error "RAPIDIA_STEPPER_PAUSE is incompatible with S_CURVE_ACCELERATION and DIRECT_STEPPING"
+  #elif IS_KINEMATIC || IS_CORE
+    #error "RAPIDIA_STEPPER_PAUSE requires a cartesian machine"
+  #endif
+#endif
+
+#if ENABLED(RAPIDIA_PAUSE_RESUME)
+  #if DISABLED(RAPIDIA_STEPPER_PAUSE)
+    #error "RAPIDIA_PAUSE_RESUME requires RAPIDIA_STEPPER_PAUSE"
+  #elif IS_KINEMATIC || IS_CORE
+    #error "RAPIDIA_PAUSE_RESUME requires a cartesian machine (planner blocks are replanned from their steps)"
+  #endif
+#endif
+
+#if ENABLED(RAPIDIA_ABL_PLANE_TABLE)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "RAPIDIA_ABL_PLANE_TABLE requires AUTO_BED_LEVELING_BILINEAR"
+  #elif ENABLED(EXTRAPOLATE_BEYOND_GRID)
+    #error "RAPIDIA_ABL_PLANE_TABLE is incompatible with EXTRAPOLATE_BEYOND_GRID"
+  #endif
+#endif
+
+#if ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+  #if DISABLED(RAPIDIA_ABL_PLANE_TABLE)
+    #error "RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS requires RAPIDIA_ABL_PLANE_TABLE"
+  #elif DISABLED(SEGMENT_LEVELED_MOVES) || IS_KINEMATIC
+    #error "RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS requires SEGMENT_LEVELED_MOVES on a cartesian machine"
+  #endif
+#endif
+
+#if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+  #if DISABLED(DUAL_X_CARRIAGE)
+    #error "RAPIDIA_IDLE_CARRIAGE requires DUAL_X_CARRIAGE"
+  #elif EITHER(S_CURVE_ACCELERATION, ADAPTIVE_STEP_SMOOTHING)
+    #error "RAPIDIA_IDLE_CARRIAGE is incompatible with S_CURVE_ACCELERATION and ADAPTIVE_STEP_SMOOTHING"
+  #elif ENABLED(RAPIDIA_PAUSE) && DISABLED(RAPIDIA_STEPPER_PAUSE)
+    #error "RAPIDIA_IDLE_CARRIAGE requires RAPIDIA_STEPPER_PAUSE (the replanning pause doesn't know carriage blocks)"
+  #elif ANY(EXT_SOLENOID, MK2_MULTIPLEXER, SWITCHING_EXTRUDER) || HAS_FANMUX
+    // (a full control mode tool change returns before these switch over.)
+    #error "RAPIDIA_IDLE_CARRIAGE is incompatible with EXT_SOLENOID, MK2_MULTIPLEXER, SWITCHING_EXTRUDER and FANMUX"
+  #endif
+#endif
+
+#if ENABLED(RAPIDIA_QUEUED_TOOL_CHANGE)
+  #if DISABLED(RAPIDIA_IDLE_CARRIAGE)
+    #error "RAPIDIA_QUEUED_TOOL_CHANGE requires RAPIDIA_IDLE_CARRIAGE"
+  #elif ANY(TOOLCHANGE_FILAMENT_SWAP, TOOLCHANGE_PARK, TOOLCHANGE_ZRAISE_BEFORE_RETRACT)
+    #error "RAPIDIA_QUEUED_TOOL_CHANGE is incompatible with TOOLCHANGE_FILAMENT_SWAP, TOOLCHANGE_PARK and TOOLCHANGE_ZRAISE_BEFORE_RETRACT"
+  #endif
+#endif
+
+#if ENABLED(RAPIDIA_FIXED_PID)
+  #if DISABLED(PIDTEMP)
+    #error "RAPIDIA_FIXED_PID requires PIDTEMP"
+  #elif ANY(PID_EXTRUSION_SCALING, PID_FAN_SCALING)
+    #error "RAPIDIA_FIXED_PID is incompatible with PID_EXTRUSION_SCALING and PID_FAN_SCALING"
+  #elif PID_FUNCTIONAL_RANGE > 50
+    #error "RAPIDIA_FIXED_PID requires a PID_FUNCTIONAL_RANGE of 50 or less"
+  #endif
+#endif
@@ -193,6 +193,7 @@
 #if ENABLED(MESH_EDIT_MENU)
 
   inline void refresh_planner() {
+    TERN_(AUTO_BED_LEVELING_BILINEAR, refresh_bed_level());
     set_current_from_steppers_for_axis(ALL_AXES);
     sync_plan_position();
   }
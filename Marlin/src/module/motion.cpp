@@ -78,6 +78,11 @@
   uint8_t __homing_semaphore_t__::_homing_semaphore = 0;
 #endif
 
+#if ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+  bool adaptive_leveled_segments = true;
+  leveled_segment_stats_t leveled_segment_stats;
+#endif
+
 /**
  * axis_homed
  *   Flags that each linear axis was homed.
@@ -591,15 +596,24 @@ void restore_feedrate_and_scaling() {
 
         // we clamp the endstops to the current position of the other extruder
         // to prevent the carriages from colliding.
+        // (while it's moving, to the nearest it comes.)
+        #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+          // (once the other carriage moves, its own moves are finished. the active carriage's
+          // moves wait for those buffered before it became active.)
+          idle_carriage_limited = idle_carriage != new_tool_index && idle_carriage_moving();
+          const float inactive_x = idle_carriage_limited ? idle_carriage_reach : inactive_extruder_x_pos;
+        #else
+          const float inactive_x = inactive_extruder_x_pos;
+        #endif
         if (!dxc_is_duplicating())
         {
           if (new_tool_index == 0)
           {
-            NOMORE(soft_endstop.max.x, inactive_extruder_x_pos - RAPIDIA_CARRIAGE_INTERVAL);
+            NOMORE(soft_endstop.max.x, inactive_x - RAPIDIA_CARRIAGE_INTERVAL);
           }
           else if (new_tool_index == 1)
           {
-            NOLESS(soft_endstop.min.x, inactive_extruder_x_pos + RAPIDIA_CARRIAGE_INTERVAL);
+            NOLESS(soft_endstop.min.x, inactive_x + RAPIDIA_CARRIAGE_INTERVAL);
           }
         }
       }
@@ -656,6 +670,12 @@ void restore_feedrate_and_scaling() {
    */
   void apply_motion_limits(xyz_pos_t &target) {
 
+    #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+      // the idle carriage has stopped, so the active one can come up to it.
+      if (idle_carriage_limited && !idle_carriage_moving())
+        update_software_endstops(X_AXIS, active_extruder, active_extruder);
+    #endif
+
     if (!soft_endstops_enabled) return;
 
     #if IS_KINEMATIC
@@ -838,6 +858,37 @@ FORCE_INLINE void segment_idle(millis_t &next_idle_ms) {
 
   #if ENABLED(SEGMENT_LEVELED_MOVES)
 
+    #if ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+
+      static xyze_pos_t cell_segment_start;
+      static feedRate_t cell_segment_fr_mm_s;
+      static millis_t cell_segment_idle_ms;
+
+      /**
+       * Buffer the piece of a leveled move within one grid cell, in
+       * as many segments as the cell's surface needs. (often one)
+       */
+      static void buffer_cell_segments(const xyze_pos_t &to) {
+        const xyze_float_t diff = to - cell_segment_start;
+        uint16_t segments = bilinear_cell_segments(cell_segment_start, to);
+        leveled_segment_stats.segments += segments;
+
+        const float inv_segments = 1.0f / float(segments),
+                    cartesian_segment_mm = xyz_float_t(diff).magnitude() * inv_segments;
+        const xyze_float_t segment_distance = diff * inv_segments;
+
+        xyze_pos_t raw = cell_segment_start;
+        cell_segment_start = to;
+        while (--segments) {
+          segment_idle(cell_segment_idle_ms);
+          raw += segment_distance;
+          if (!planner.buffer_line(raw, cell_segment_fr_mm_s, active_extruder, cartesian_segment_mm)) return;
+        }
+        planner.buffer_line(to, cell_segment_fr_mm_s, active_extruder, cartesian_segment_mm);
+      }
+
+    #endif
+
     /**
      * Prepare a segmented move on a CARTESIAN setup.
      *
@@ -855,6 +906,18 @@ FORCE_INLINE void segment_idle(millis_t &next_idle_ms) {
         return;
       }
 
+      #if ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+        leveled_segment_stats.moves++;
+        if (adaptive_leveled_segments) {
+          // Split where the move crosses the grid, and within each cell to the tolerance
+          cell_segment_start = current_position;
+          cell_segment_fr_mm_s = fr_mm_s;
+          cell_segment_idle_ms = millis() + 200UL;
+          bilinear_cell_walk(current_position, destination, buffer_cell_segments);
+          return;
+        }
+      #endif
+
       // Get the linear distance in XYZ
       // If the move is very short, check the E move distance
       // No E move either? Game over.
@@ -866,6 +929,7 @@ FORCE_INLINE void segment_idle(millis_t &next_idle_ms) {
       // At least one segment is required
       uint16_t segments = cartesian_mm / segment_size;
       NOLESS(segments, 1U);
+      TERN_(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS, leveled_segment_stats.segments += segments);
 
       // The approximate length of each segment
       const float inv_segments = 1.0f / float(segments),
@@ -966,6 +1030,46 @@ FORCE_INLINE void segment_idle(millis_t &next_idle_ms) {
   millis_t delayed_move_time             = 0;                             // used in mode 1
   int16_t duplicate_extruder_temp_offset = 0;                             // used in mode 2
 
+  #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+    uint8_t idle_carriage_moves = 0,
+            idle_carriage;
+    float idle_carriage_reach;
+    bool idle_carriage_limited = false;
+
+    // whether a buffered move of the idle carriage hasn't finished.
+    // (taken is read first: the ISR counts a move taken before it sets it moving.)
+    bool idle_carriage_moving() {
+      const uint8_t taken = stepper.carriage_moves_taken;
+      return idle_carriage_moves != taken || stepper.carriage_moving;
+    }
+
+    /**
+     * Buffer a move of the idle carriage (in full control mode) to native x, kept
+     * RAPIDIA_CARRIAGE_INTERVAL clear of where the active carriage is planned to be.
+     * The active carriage's soft endstops keep clear of the nearest it comes until it stops.
+     * Returns the x it will move to.
+     */
+    float idle_carriage_move_to(float x, const feedRate_t &fr_mm_s) {
+      const uint8_t idle = !active_extruder;
+      const float from = inactive_extruder_x_pos;
+      if (idle)
+        LIMIT(x, _MAX(X2_MIN_POS, current_position.x + RAPIDIA_CARRIAGE_INTERVAL), x_home_pos(1));
+      else
+        LIMIT(x, X1_MIN_POS, _MIN(X1_MAX_POS, current_position.x - RAPIDIA_CARRIAGE_INTERVAL));
+
+      const bool moving = idle_carriage_moving();
+      if (planner.buffer_carriage_move(idle, from, x, fr_mm_s)) {
+        if (idle != idle_carriage || !moving) idle_carriage_reach = from;
+        idle_carriage = idle;
+        if (idle) NOMORE(idle_carriage_reach, x); else NOLESS(idle_carriage_reach, x);
+        idle_carriage_moves++;
+      }
+      inactive_extruder_x_pos = x;
+      update_software_endstops(X_AXIS, active_extruder, active_extruder);
+      return x;
+    }
+  #endif
+
   float x_home_pos(const uint8_t extruder) {
     if (extruder == 0)
       return base_home_pos(X_AXIS);
@@ -222,6 +222,16 @@ void line_to_current_position(const feedRate_t &fr_mm_s=feedrate_mm_s);
 
 void prepare_line_to_destination();
 
+#if ENABLED(RAPIDIA_ADAPTIVE_LEVELED_SEGMENTS)
+  // leveled moves are split per grid cell to RAPIDIA_LEVELED_SEGMENT_TOLERANCE (true),
+  // or into LEVELED_SEGMENT_LENGTH pieces (false). (R809 S)
+  extern bool adaptive_leveled_segments;
+
+  // leveled moves, and the segments they were split into. (R809)
+  typedef struct { uint32_t moves, segments; } leveled_segment_stats_t;
+  extern leveled_segment_stats_t leveled_segment_stats;
+#endif
+
 void _internal_move_to_destination(const feedRate_t &fr_mm_s=0.0f
   #if IS_KINEMATIC
     , const bool is_fast=false
@@ -409,6 +419,16 @@ bool homing_needed_error(uint8_t axis_bits=0x07);
 
   FORCE_INLINE int x_home_dir(const uint8_t extruder) { return extruder ? X2_HOME_DIR : X_HOME_DIR; }
 
+  #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+    extern uint8_t idle_carriage_moves;           // Idle carriage moves buffered (R762), to compare with those the stepper took
+    extern uint8_t idle_carriage;                 // Carriage of the last of them
+    extern float idle_carriage_reach;             // Nearest it comes to the other one while it moves
+    extern bool idle_carriage_limited;            // The X soft endstops are to be updated once it stops
+
+    bool idle_carriage_moving();
+    float idle_carriage_move_to(float x, const feedRate_t &fr_mm_s);
+  #endif
+
 #else
 
   #if ENABLED(MULTI_NOZZLE_DUPLICATION)
@@ -111,10 +111,6 @@
   #include "../feature/spindle_laser.h"
 #endif
 
-#if ENABLED(RAPIDIA_MILEAGE)
-  #include "../feature/rapidia/mileage.h"
-#endif
-
 // Delay for delivery of first block to the stepper ISR, if the queue contains 2 or
 // fewer movements. The delay is measured in milliseconds, and must be less than 250ms
 #define BLOCK_DELAY_FOR_1ST_MOVE 100
@@ -164,11 +160,32 @@ float Planner::steps_to_mm[XYZE_N];             // (mm) Millimeters per step
   bool Planner::auto_report_line_finished = false;
 #endif
 
+#if ENABLED(RAPIDIA_INCREMENTAL_REPLAN)
+  bool Planner::incremental_replan = true;
+
+  // the first block this recalculate() may change: where the reverse pass
+  // stopped early, and then where the forward pass started.
+  static bool replan_partial;
+  static uint8_t replan_index;
+#endif
+
+#if ENABLED(RAPIDIA_REPLAN_STATS)
+  Planner::replan_stats_t Planner::replan_stats;
+  static uint8_t replan_visited; // blocks visited by this recalculate()
+  #define REPLAN_VISIT(PASS) do{ ++replan_stats.PASS; ++replan_visited; }while(0)
+#else
+  #define REPLAN_VISIT(PASS) NOOP
+#endif
+
 #if ENABLED(RAPIDIA_PAUSE)
   bool Planner::prevent_block_buffering = false;
   bool Planner::prevent_block_extrusion = false;
 #endif
 
+#if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+  bool Planner::carriage_swap = false;
+#endif
+
 #if ENABLED(DISTINCT_E_FACTORS)
   uint8_t Planner::last_extruder = 0;     // Respond to extruder change
 #endif
@@ -780,6 +797,69 @@ block_t* Planner::get_current_block() {
   return nullptr;
 }
 
+bool Planner::trapezoid_steps_float(uint32_t &accelerate_steps, uint32_t &plateau_steps,
+  const uint32_t nominal_rate, const uint32_t initial_rate, const uint32_t final_rate,
+  const int32_t accel, const uint32_t step_event_count
+) {
+          // Steps required for acceleration, deceleration to/from nominal rate
+  accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, nominal_rate, accel));
+  const uint32_t decelerate_steps = FLOOR(estimate_acceleration_distance(nominal_rate, final_rate, -accel));
+          // Steps between acceleration and deceleration, if any
+  const int32_t steps = step_event_count - accelerate_steps - decelerate_steps;
+
+  // Does accelerate_steps + decelerate_steps exceed step_event_count?
+  // Then we can't possibly reach the nominal rate, there will be no cruising.
+  // Use intersection_distance() to calculate accel / braking time in order to
+  // reach the final_rate exactly at the end of this block.
+  if (steps < 0) {
+    const float accelerate_steps_float = CEIL(intersection_distance(initial_rate, final_rate, accel, step_event_count));
+    accelerate_steps = _MIN(uint32_t(_MAX(accelerate_steps_float, 0)), step_event_count);
+    plateau_steps = 0;
+    return false;
+  }
+
+  plateau_steps = steps;
+  return true;
+}
+
+#if ENABLED(RAPIDIA_FIXED_TRAPEZOID)
+
+  /**
+   * The same ceilings and floors of the same quotients as trapezoid_steps_float(), taken
+   * exactly, with one 32-bit division each. Every rate here is at most nominal_rate, so
+   * with nominal_rate^2 and 2 * accel below 2^31 nothing overflows.
+   */
+  bool Planner::trapezoid_steps_fixed(uint32_t &accelerate_steps, uint32_t &plateau_steps,
+    const uint32_t nominal_rate, const uint32_t initial_rate, const uint32_t final_rate,
+    const int32_t accel, const uint32_t step_event_count
+  ) {
+    if (nominal_rate > 46340 || accel <= 0 || accel > 0x3FFFFFFF || initial_rate > nominal_rate || final_rate > nominal_rate)
+      return trapezoid_steps_float(accelerate_steps, plateau_steps, nominal_rate, initial_rate, final_rate, accel, step_event_count);
+
+    const uint32_t nominal_sqr = sq(nominal_rate), initial_sqr = sq(initial_rate), final_sqr = sq(final_rate),
+                   accel_x2 = uint32_t(accel) * 2;
+
+    // (n^2 - i^2) / 2a rounded up, (n^2 - f^2) / 2a rounded down
+    const uint32_t accelerate_sqr = nominal_sqr - initial_sqr;
+    accelerate_steps = accelerate_sqr / accel_x2 + (accelerate_sqr % accel_x2 != 0);
+    const uint32_t decelerate_steps = (nominal_sqr - final_sqr) / accel_x2;
+
+    if (accelerate_steps + decelerate_steps <= step_event_count) {
+      plateau_steps = step_event_count - accelerate_steps - decelerate_steps;
+      return true;
+    }
+
+    // No plateau: (2ad - i^2 + f^2) / 4a rounded up, taken as (ad + (f^2 - i^2) / 2, rounded up) / 2a
+    // rounded up. d < accelerate_steps + decelerate_steps here, so ad < n^2.
+    const int32_t diff_sqr = int32_t(final_sqr) - int32_t(initial_sqr),
+                  half_dist = int32_t(uint32_t(accel) * step_event_count) + (diff_sqr < 0 ? diff_sqr / 2 : (diff_sqr + 1) / 2);
+    accelerate_steps = half_dist <= 0 ? 0 : _MIN(uint32_t(half_dist) / accel_x2 + (uint32_t(half_dist) % accel_x2 != 0), step_event_count);
+    plateau_steps = 0;
+    return false;
+  }
+
+#endif
+
 /**
  * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
  * by the provided factors.
@@ -805,27 +885,16 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
 
   const int32_t accel = block->acceleration_steps_per_s2;
 
-          // Steps required for acceleration, deceleration to/from nominal rate
-  uint32_t accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, block->nominal_rate, accel)),
-           decelerate_steps = FLOOR(estimate_acceleration_distance(block->nominal_rate, final_rate, -accel));
-          // Steps between acceleration and deceleration, if any
-  int32_t plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
-
-  // Does accelerate_steps + decelerate_steps exceed step_event_count?
-  // Then we can't possibly reach the nominal rate, there will be no cruising.
-  // Use intersection_distance() to calculate accel / braking time in order to
-  // reach the final_rate exactly at the end of this block.
-  if (plateau_steps < 0) {
-    const float accelerate_steps_float = CEIL(intersection_distance(initial_rate, final_rate, accel, block->step_event_count));
-    accelerate_steps = _MIN(uint32_t(_MAX(accelerate_steps_float, 0)), block->step_event_count);
-    plateau_steps = 0;
+  // Steps accelerating, then cruising at the nominal rate if there's room to reach it
+  uint32_t accelerate_steps, plateau_steps;
+  const bool plateau = TERN(RAPIDIA_FIXED_TRAPEZOID, trapezoid_steps_fixed, trapezoid_steps_float)(
+    accelerate_steps, plateau_steps, block->nominal_rate, initial_rate, final_rate, accel, block->step_event_count
+  );
+  UNUSED(plateau);
 
-    #if ENABLED(S_CURVE_ACCELERATION)
-      // We won't reach the cruising rate. Let's calculate the speed we will reach
-      cruise_rate = final_speed(initial_rate, accel, accelerate_steps);
-    #endif
-  }
   #if ENABLED(S_CURVE_ACCELERATION)
+    if (!plateau) // We won't reach the cruising rate. Let's calculate the speed we will reach
+      cruise_rate = final_speed(initial_rate, accel, accelerate_steps);
     else // We have some plateau time, so the cruise rate will be the nominal rate
       cruise_rate = block->nominal_rate;
   #endif
@@ -1029,10 +1098,27 @@ void Planner::reverse_pass() {
 
     // Perform the reverse pass
     block_t *current = &block_buffer[block_index];
+    REPLAN_VISIT(reverse);
 
     // Only consider non sync and page blocks
     if (!TEST(current->flag, BLOCK_BIT_SYNC_POSITION) && !IS_PAGE(current)) {
+      #if ENABLED(RAPIDIA_INCREMENTAL_REPLAN)
+        const float entry_speed_sqr = current->entry_speed_sqr;
+      #endif
+
       reverse_pass_kernel(current, next);
+
+      #if ENABLED(RAPIDIA_INCREMENTAL_REPLAN)
+        // Adding a block can only raise the reverse-planned entry speeds behind it. So if this
+        // (older) block's entry speed is unchanged, it was already what the reverse pass gives,
+        // and so is everything behind it. Stop here, and plan forward from this block.
+        if (incremental_replan && next && entry_speed_sqr == current->entry_speed_sqr && !TEST(current->flag, BLOCK_BIT_RECALCULATE)) {
+          replan_partial = true;
+          replan_index = block_index;
+          return;
+        }
+      #endif
+
       next = current;
     }
 
@@ -1118,12 +1204,22 @@ void Planner::forward_pass() {
   //  pass will never modify the values at the tail.
   uint8_t block_index = block_buffer_planned;
 
+  #if ENABLED(RAPIDIA_INCREMENTAL_REPLAN)
+    // Start where the reverse pass stopped, unless the ISR has since moved the planned pointer past it.
+    if (replan_partial && BLOCK_MOD(replan_index - block_index) < BLOCK_MOD(block_buffer_head - block_index))
+      block_index = replan_index;
+    // Blocks before this one are unchanged, and this one's entry speed doesn't change.
+    replan_partial = incremental_replan;
+    replan_index = block_index;
+  #endif
+
   block_t *block;
   const block_t * previous = nullptr;
   while (block_index != block_buffer_head) {
 
     // Perform the forward pass
     block = &block_buffer[block_index];
+    REPLAN_VISIT(forward);
 
     // Skip SYNC and page blocks
     if (!TEST(block->flag, BLOCK_BIT_SYNC_POSITION) && !IS_PAGE(block)) {
@@ -1168,12 +1264,19 @@ void Planner::recalculate_trapezoids() {
     head_block_index = prev_index;
   }
 
+  #if ENABLED(RAPIDIA_INCREMENTAL_REPLAN)
+    // No block before the one the forward pass started at has changed, nor has its exit speed.
+    if (replan_partial && BLOCK_MOD(replan_index - block_index) < BLOCK_MOD(head_block_index - block_index))
+      block_index = replan_index;
+  #endif
+
   // Go from the tail (currently executed block) to the first block, without including it)
   block_t *block = nullptr, *next = nullptr;
   float current_entry_speed = 0.0, next_entry_speed = 0.0;
   while (block_index != head_block_index) {
 
     next = &block_buffer[block_index];
+    REPLAN_VISIT(trapezoid);
 
     // Skip sync and page blocks
     if (!TEST(next->flag, BLOCK_BIT_SYNC_POSITION) && !IS_PAGE(next)) {
@@ -1198,6 +1301,7 @@ void Planner::recalculate_trapezoids() {
             const float current_nominal_speed = SQRT(block->nominal_speed_sqr),
                         nomr = 1.0f / current_nominal_speed;
             calculate_trapezoid_for_block(block, current_entry_speed * nomr, next_entry_speed * nomr);
+            TERN_(RAPIDIA_REPLAN_STATS, ++replan_stats.recalculated);
             #if ENABLED(LIN_ADVANCE)
               if (block->use_advance_lead) {
                 const float comp = block->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
@@ -1237,6 +1341,7 @@ void Planner::recalculate_trapezoids() {
       const float next_nominal_speed = SQRT(next->nominal_speed_sqr),
                   nomr = 1.0f / next_nominal_speed;
       calculate_trapezoid_for_block(next, next_entry_speed * nomr, float(MINIMUM_PLANNER_SPEED) * nomr);
+      TERN_(RAPIDIA_REPLAN_STATS, ++replan_stats.recalculated);
       #if ENABLED(LIN_ADVANCE)
         if (next->use_advance_lead) {
           const float comp = next->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
@@ -1253,6 +1358,12 @@ void Planner::recalculate_trapezoids() {
 }
 
 void Planner::recalculate() {
+  #if ENABLED(RAPIDIA_REPLAN_STATS)
+    const uint32_t start_us = micros();
+    replan_visited = 0;
+  #endif
+  TERN_(RAPIDIA_INCREMENTAL_REPLAN, replan_partial = false);
+
   // Initialize block index to the last block in the planner buffer.
   const uint8_t block_index = prev_block_index(block_buffer_head);
   // If there is just one block, no planning can be done. Avoid it!
@@ -1261,6 +1372,14 @@ void Planner::recalculate() {
     forward_pass();
   }
   recalculate_trapezoids();
+
+  #if ENABLED(RAPIDIA_REPLAN_STATS)
+    const uint32_t us = micros() - start_us;
+    replan_stats.inserts++;
+    replan_stats.us += us;
+    NOLESS(replan_stats.us_max, us);
+    NOLESS(replan_stats.visited_max, replan_visited);
+  #endif
 }
 
 #if ENABLED(AUTOTEMP)
@@ -1585,6 +1704,8 @@ void Planner::quick_stop() {
 
   const bool was_enabled = stepper.suspend();
 
+  TERN_(RAPIDIA_IDLE_CARRIAGE, drop_carriage_blocks(true));
+
   // Drop all queue entries
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
 
@@ -1657,6 +1778,7 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
 void Planner::synchronize() {
   while (has_blocks_queued() || cleaning_buffer_counter
       || TERN0(EXTERNAL_CLOSED_LOOP_CONTROLLER, CLOSED_LOOP_WAITING())
+      || TERN0(RAPIDIA_IDLE_CARRIAGE, stepper.carriage_moving)
   ) idle();
 }
 
@@ -2650,6 +2772,13 @@ void Planner::buffer_sync_block() {
 
   block->position = position;
 
+  #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+    // (were a tool change discarded, the old tool would be active again, and the new
+    // tool's carriage idle at position.x.)
+    if (carriage_swap) block->flag |= BLOCK_FLAG_CARRIAGE;
+    block->extruder = active_extruder;
+  #endif
+
   // If this is the first added movement, reload the delay, otherwise, cancel it.
   if (block_buffer_head == block_buffer_tail) {
     // If it was the first queued block, restart the 1st block delivery delay, to
@@ -2665,6 +2794,85 @@ void Planner::buffer_sync_block() {
   stepper.wake_up();
 } // buffer_sync_block()
 
+#if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+
+/**
+ * Planner::buffer_carriage_move
+ *
+ * The stepper ISR takes the move when it reaches the block, so the active carriage's blocks
+ * before it are done, and the moving carriage's blocks after it wait until it's there.
+ * (it's a sync block, so the planner's passes and a pause pass over it.) The move is a
+ * trapezoid from and to rest, at up to half the single-stepping ISR rate.
+ */
+bool Planner::buffer_carriage_move(const uint8_t carriage, const float &from, const float &to, const feedRate_t &fr_mm_s) {
+  const float steps_per_mm = settings.axis_steps_per_mm[X_AXIS];
+  const int32_t start = LROUND(from * steps_per_mm), target = LROUND(to * steps_per_mm);
+  if (start == target) return false;
+
+  // Wait for the next available block
+  uint8_t next_buffer_head;
+  block_t * const block = get_next_free_block(next_buffer_head);
+
+  memset(block, 0, sizeof(block_t));
+
+  #if ENABLED(RAPIDIA_BLOCK_SOURCE)
+    block->source_line = NO_SOURCE_LINE;
+  #endif
+
+  block->flag = BLOCK_FLAG_SYNC_POSITION | BLOCK_FLAG_CARRIAGE;
+  block->extruder = carriage;
+  block->position.x = target;
+  block->step_event_count = ABS(target - start);
+  if (target < start) SBI(block->direction_bits, X_AXIS);
+
+  const uint32_t accel = _MIN(uint32_t(settings.travel_acceleration * steps_per_mm), max_acceleration_steps_per_s2[X_AXIS]);
+  block->acceleration_steps_per_s2 = accel;
+  block->acceleration_rate = (uint32_t)(accel * (4096.0f * 4096.0f / (STEPPER_TIMER_RATE)));
+  block->initial_rate = block->final_rate = MINIMAL_STEP_RATE;
+  block->nominal_rate = LROUND(_MIN(fr_mm_s, settings.max_feedrate_mm_s[X_AXIS]) * steps_per_mm);
+  LIMIT(block->nominal_rate, uint32_t(MINIMAL_STEP_RATE), uint32_t((MAX_STEP_ISR_FREQUENCY_1X) / 2));
+
+  uint32_t accelerate_steps, plateau_steps;
+  TERN(RAPIDIA_FIXED_TRAPEZOID, trapezoid_steps_fixed, trapezoid_steps_float)(
+    accelerate_steps, plateau_steps, block->nominal_rate, block->initial_rate, block->final_rate, accel, block->step_event_count);
+  block->accelerate_until = accelerate_steps;
+  block->decelerate_after = accelerate_steps + plateau_steps;
+
+  if (block_buffer_head == block_buffer_tail) delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
+
+  block_buffer_head = next_buffer_head;
+
+  ENABLE_AXIS_X();
+  stepper.wake_up();
+  return true;
+}
+
+/**
+ * Blocks are being discarded: a carriage move or tool change among them didn't happen, so
+ * the carriages are as the first of them would have found them. A quick stop also cuts short
+ * the idle carriage's move. (with the stepper ISR suspended.)
+ */
+void Planner::drop_carriage_blocks(const bool stop) {
+  for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
+    const block_t &block = block_buffer[b];
+    if (!TEST(block.flag, BLOCK_BIT_CARRIAGE)) continue;
+    // (a move's block has the idle carriage, a swap's the carriage it made active.)
+    int32_t idle_x = block.position.x;
+    if (block.step_event_count)
+      idle_x += TEST(block.direction_bits, X_AXIS) ? int32_t(block.step_event_count) : -int32_t(block.step_event_count);
+    active_extruder = !block.extruder;
+    inactive_extruder_x_pos = idle_x * steps_to_mm[X_AXIS];
+    active_extruder_parked = false; // (the active carriage is wherever it stopped)
+    break;
+  }
+  if (stop && stepper.carriage_moving)
+    inactive_extruder_x_pos = stepper.carriage_stop() * steps_to_mm[X_AXIS];
+  idle_carriage_moves = stepper.carriage_moves_taken;
+  idle_carriage_limited = true;
+}
+
+#endif // RAPIDIA_IDLE_CARRIAGE
+
 #ifdef RAPIDIA_PAUSE
 // information returned by helper function below.
 
@@ -2682,7 +2890,7 @@ inline void Planner::pause_clear_e_from_buffer()
     block_t& block = planner.block_buffer[block_index];
 
     // we skip sync blocks because they use block::steps for other information.
-    if (! (block.flag & BLOCK_BIT_SYNC_POSITION))
+    if (!TEST(block.flag, BLOCK_BIT_SYNC_POSITION))
     {
       // any block which, as a result, is empty, should be culled.
       if (block.steps[X_AXIS] == 0 && block.steps[Y_AXIS] == 0 && block.steps[Z_AXIS] == 0)
@@ -2708,6 +2916,80 @@ inline void Planner::pause_clear_e_from_buffer()
   stepper.stop_e_motion();
 }
 
+#if ENABLED(RAPIDIA_STEPPER_PAUSE)
+void Planner::pause_discard_blocks()
+{
+  const bool was_enabled = stepper.suspend();
+  TERN_(RAPIDIA_IDLE_CARRIAGE, drop_carriage_blocks(false));
+  block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
+
+  // As the queue is empty, the ISR won't touch this.
+  delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
+
+  TERN_(HAS_SPI_LCD, clear_block_buffer_runtime());
+  if (was_enabled) stepper.wake_up();
+}
+
+block_t* Planner::pause_carry_block(const block_t * const current)
+{
+  const uint8_t b = next_block_index(current - block_buffer);
+  if (b == block_buffer_head) return nullptr;
+
+  block_t * const block = &block_buffer[b];
+  if (TEST(block->flag, BLOCK_BIT_RECALCULATE) || TEST(block->flag, BLOCK_BIT_SYNC_POSITION)
+    || !(block->steps.a || block->steps.b || block->steps.c) || block->extruder != current->extruder
+  ) return nullptr;
+
+  // (as get_current_block())
+  TERN_(HAS_SPI_LCD, block_buffer_runtime_us -= block->segment_time_us);
+  block_buffer_nonbusy = next_block_index(b);
+  if (b == block_buffer_planned) block_buffer_planned = block_buffer_nonbusy;
+  return block;
+}
+#endif
+
+#if ENABLED(RAPIDIA_PAUSE_RESUME)
+int8_t Planner::pause_keep_moves(pause_move_t moves[], xyz_long_t &start, source_line_t &line, const bool to_line_end)
+{
+  auto signed_steps = [](const block_t &block, const uint8_t axis) {
+    return TEST(block.direction_bits, axis) ? -int32_t(block.steps[axis]) : int32_t(block.steps[axis]);
+  };
+
+  // the first block starts where the last ends, less the steps of them all.
+  // (a sync block's steps aren't a move.)
+  LOOP_XYZ(axis) start[axis] = position[axis];
+  for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b))
+  {
+    const block_t &block = block_buffer[b];
+    if (TEST(block.flag, BLOCK_BIT_SYNC_POSITION)) return -1;
+    LOOP_XYZ(axis) start[axis] -= signed_steps(block, axis);
+  }
+
+  line = NO_SOURCE_LINE;
+  if (!to_line_end) return 0;
+
+  xyz_long_t end = start;
+  int8_t count = 0;
+  for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b))
+  {
+    const block_t &block = block_buffer[b];
+    LOOP_XYZ(axis) end[axis] += signed_steps(block, axis);
+
+    pause_move_t &move = moves[count++];
+    move.target = end;
+    move.e_steps = signed_steps(block, E_AXIS);
+    move.fr_mm_s = SQRT(block.nominal_speed_sqr);
+
+    if (block.source_line != NO_SOURCE_LINE)
+    {
+      line = block.source_line;
+      return count;
+    }
+  }
+  return -1;
+}
+#endif
+
 template<bool force>
 inline Planner::pause_scan_result Planner::pause_decelerate_scan()
 {
@@ -2977,10 +3259,6 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
     }
   #endif
 
-  #if ENABLED(RAPIDIA_MILEAGE)
-    Rapidia::mileage.increment_e_mm_tally(extruder, Rapidia::double_to_mileage(e));
-  #endif
-
   // The target position of the tool in absolute steps
   // Calculate target position in absolute steps
   const abce_long_t target = {
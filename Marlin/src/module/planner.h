@@ -113,6 +113,11 @@ enum BlockFlagBit : char {
   #if ENABLED(DIRECT_STEPPING)
     , BLOCK_BIT_IS_PAGE
   #endif
+
+  // A sync block which moves the idle X carriage (with steps) or swaps the carriages (without)
+  #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+    , BLOCK_BIT_CARRIAGE
+  #endif
 };
 
 enum BlockFlag : char {
@@ -123,6 +128,9 @@ enum BlockFlag : char {
   #if ENABLED(DIRECT_STEPPING)
     , BLOCK_FLAG_IS_PAGE            = _BV(BLOCK_BIT_IS_PAGE)
   #endif
+  #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+    , BLOCK_FLAG_CARRIAGE           = _BV(BLOCK_BIT_CARRIAGE)
+  #endif
 };
 
 #if ENABLED(LASER_POWER_INLINE)
@@ -335,6 +343,45 @@ class Planner {
       static bool auto_report_line_finished;
     #endif
 
+    #if ENABLED(RAPIDIA_INCREMENTAL_REPLAN)
+      // the reverse pass stops at the first block whose entry speed the new block
+      // leaves unchanged, and the rest of recalculate() starts from that block. (R808 S)
+      static bool incremental_replan;
+    #endif
+
+    #if ENABLED(RAPIDIA_REPLAN_STATS)
+      // work done by recalculate(), one call per new block. (R808)
+      typedef struct {
+        uint32_t inserts,       // recalculate() calls
+                 reverse,       // blocks visited by each pass
+                 forward,
+                 trapezoid,
+                 recalculated,  // trapezoids computed
+                 us,            // time spent in recalculate()
+                 us_max;
+        uint8_t visited_max;    // most blocks visited by one call (all passes)
+      } replan_stats_t;
+      static replan_stats_t replan_stats;
+    #endif
+
+    /**
+     * Steps a block of step_event_count steps spends accelerating, and then cruising at
+     * nominal_rate, entered at initial_rate and left at final_rate (steps/s), at accel (steps/s^2).
+     * Returns false if there's no room to reach nominal_rate: the block then accelerates and
+     * decelerates, with no plateau, reaching final_rate at its end.
+     */
+    static bool trapezoid_steps_float(uint32_t &accelerate_steps, uint32_t &plateau_steps,
+      const uint32_t nominal_rate, const uint32_t initial_rate, const uint32_t final_rate,
+      const int32_t accel, const uint32_t step_event_count);
+
+    #if ENABLED(RAPIDIA_FIXED_TRAPEZOID)
+      // the same in 32-bit integer arithmetic, for calculate_trapezoid_for_block().
+      // (exact, where float rounds; out of its range, falls back to trapezoid_steps_float.)
+      static bool trapezoid_steps_fixed(uint32_t &accelerate_steps, uint32_t &plateau_steps,
+        const uint32_t nominal_rate, const uint32_t initial_rate, const uint32_t final_rate,
+        const int32_t accel, const uint32_t step_event_count);
+    #endif
+
     #if ENABLED(RAPIDIA_PAUSE)
       // prevents additional blocks from being planned.
       // causes Planner::_buffer_steps to return false.
@@ -739,6 +786,18 @@ class Planner {
      */
     static void buffer_sync_block();
 
+    #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+      /**
+       * Planner::buffer_carriage_move
+       * Add a block which hands a move of the idle X carriage (from, to: mm) to the stepper ISR,
+       * to step alongside the blocks after it. Returns false if it wouldn't take a step.
+       */
+      static bool buffer_carriage_move(const uint8_t carriage, const float &from, const float &to, const feedRate_t &fr_mm_s);
+
+      // the next sync block is a tool change between the X carriages. (set around sync_plan_position.)
+      static bool carriage_swap;
+    #endif
+
     #ifdef RAPIDIA_BLOCK_SOURCE
       /**
        * Mark the most recently added block as being the last block added by a particular line of gcode,
@@ -777,6 +836,30 @@ class Planner {
       static pause_result pause_decelerate(bool force);
       static void pause_clear_e_from_buffer();
 
+      #if ENABLED(RAPIDIA_STEPPER_PAUSE)
+        // drops the blocks a pause carried out by the stepper ISR left behind.
+        // (only once the steppers have stopped: the ISR takes no blocks until it's released.)
+        static void pause_discard_blocks();
+
+        // the move after the given block, for the stepper ISR to decelerate on into while pausing, if it's ready
+        // and on the same carriage. it's made busy but left in the buffer, so it isn't reported as done.
+        static block_t* pause_carry_block(const block_t * const block);
+      #endif
+
+      #if ENABLED(RAPIDIA_PAUSE_RESUME)
+        // a move of the gcode a pause interrupted, kept to resume it (R754).
+        typedef struct {
+          xyz_long_t target;  // where it ends (steps)
+          int32_t e_steps;    // its extrusion
+          feedRate_t fr_mm_s;
+        } pause_move_t;
+
+        // copies the blocks left in the buffer (at most BLOCK_BUFFER_SIZE - 1), up to the last block of the
+        // gcode being executed, and its source line. start is where the first of them starts. returns how many, or -1
+        // if that gcode's last block isn't in the buffer. (once the steppers have stopped, before pause_discard_blocks().)
+        static int8_t pause_keep_moves(pause_move_t moves[], xyz_long_t &start, source_line_t &line, const bool to_line_end);
+      #endif
+
     private:
       // force: if false, stop only at marked boundaries. Otherwise,
       // stop as soon as possible.
@@ -1008,6 +1091,11 @@ public:
     static constexpr uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
     static constexpr uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
 
+    #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+      // Undo the carriage moves and swaps among blocks being discarded
+      static void drop_carriage_blocks(const bool stop);
+    #endif
+
     /**
      * Calculate the distance (not time) it takes to accelerate
      * from initial_rate to target_rate using the given acceleration:
@@ -136,6 +136,12 @@ Stepper stepper; // Singleton
   #include "../feature/spindle_laser.h"
 #endif
 
+#if ENABLED(RAPIDIA_MILEAGE)
+  #include "../feature/rapidia/mileage.h"
+#endif
+
+#include "../feature/rapidia/isr_profiler.h"
+
 // public:
 
 #if EITHER(HAS_EXTRA_ENDSTOPS, Z_STEPPER_AUTO_ALIGN)
@@ -227,6 +233,13 @@ uint32_t Stepper::advance_divisor = 0,
   uint32_t Stepper::nextBabystepISR = BABYSTEP_NEVER;
 #endif
 
+#if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+  uint32_t Stepper::nextCarriageISR = CARRIAGE_NEVER;
+  Stepper::carriage_move_t Stepper::carriage_move;
+  volatile uint8_t Stepper::carriage_moves_taken = 0;
+  volatile bool Stepper::carriage_moving = false;
+#endif
+
 #if ENABLED(DIRECT_STEPPING)
   page_step_state_t Stepper::page_step_state;
 #endif
@@ -236,6 +249,15 @@ int32_t Stepper::ticks_nominal = -1;
   uint32_t Stepper::acc_step_rate; // needed for deceleration start point
 #endif
 
+#if ENABLED(RAPIDIA_STEPPER_PAUSE)
+  volatile Stepper::PauseState Stepper::pause_state = PAUSE_NONE;
+  Stepper::pause_info_t Stepper::pause_info;
+  bool Stepper::pause_taken = false;
+  block_t* Stepper::pause_carry = nullptr;
+  bool Stepper::pause_carried = false;
+  uint32_t Stepper::pause_exit_rate;
+#endif
+
 xyz_long_t Stepper::endstops_trigsteps;
 xyze_long_t Stepper::count_position{0};
 xyze_int8_t Stepper::count_direction{0};
@@ -1355,6 +1377,10 @@ void Stepper::isr() {
 
   static uint32_t nextMainISR = 0;  // Interval until the next main Stepper Pulse phase (0 = Now)
 
+  #if ENABLED(RAPIDIA_ISR_PROFILER)
+    const hal_timer_t isr_start = HAL_timer_get_count(STEP_TIMER_NUM);
+  #endif
+
   #ifndef __AVR__
     // Disable interrupts, to avoid ISR preemption while we reprogram the period
     // (AVR enters the ISR with global interrupts disabled, so no need to do it here)
@@ -1378,10 +1404,14 @@ void Stepper::isr() {
     // Enable ISRs to reduce USART processing latency
     ENABLE_ISRS();
 
-    if (!nextMainISR) pulse_phase_isr();                            // 0 = Do coordinated axes Stepper pulses
+    if (!nextMainISR) RAPIDIA_ISR_PROFILE(Rapidia::ISR_PHASE_PULSE, pulse_phase_isr());                     // 0 = Do coordinated axes Stepper pulses
 
     #if ENABLED(LIN_ADVANCE)
-      if (!nextAdvanceISR) nextAdvanceISR = advance_isr();          // 0 = Do Linear Advance E Stepper pulses
+      if (!nextAdvanceISR) RAPIDIA_ISR_PROFILE(Rapidia::ISR_PHASE_ADVANCE, nextAdvanceISR = advance_isr()); // 0 = Do Linear Advance E Stepper pulses
+    #endif
+
+    #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+      if (!nextCarriageISR) nextCarriageISR = carriage_isr();     // 0 = Do idle X carriage pulses
     #endif
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
@@ -1391,7 +1421,7 @@ void Stepper::isr() {
 
     // ^== Time critical. NOTHING besides pulse generation should be above here!!!
 
-    if (!nextMainISR) nextMainISR = block_phase_isr();  // Manage acc/deceleration, get next block
+    if (!nextMainISR) RAPIDIA_ISR_PROFILE(Rapidia::ISR_PHASE_BLOCK, nextMainISR = block_phase_isr());  // Manage acc/deceleration, get next block
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       if (is_babystep)                                  // Avoid ANY stepping too soon after baby-stepping
@@ -1407,6 +1437,9 @@ void Stepper::isr() {
       #if ENABLED(LIN_ADVANCE)
         , nextAdvanceISR                                // Come back early for Linear Advance?
       #endif
+      #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+        , nextCarriageISR                               // Come back early for the idle carriage?
+      #endif
       #if ENABLED(INTEGRATED_BABYSTEPPING)
         , nextBabystepISR                               // Come back early for Babystepping?
       #endif
@@ -1426,6 +1459,10 @@ void Stepper::isr() {
       if (nextAdvanceISR != LA_ADV_NEVER) nextAdvanceISR -= interval;
     #endif
 
+    #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+      if (nextCarriageISR != CARRIAGE_NEVER) nextCarriageISR -= interval;
+    #endif
+
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       if (nextBabystepISR != BABYSTEP_NEVER) nextBabystepISR -= interval;
     #endif
@@ -1487,7 +1524,14 @@ void Stepper::isr() {
      * loop to 10 iterations. Beyond that, there's no way to ensure correct pulse
      * timing, since the MCU isn't fast enough.
      */
-    if (!--max_loops) next_isr_ticks = min_ticks;
+    if (!--max_loops) {
+      TERN_(RAPIDIA_ISR_PROFILER, Rapidia::IsrProfiler::loop_limit());
+      next_isr_ticks = min_ticks;
+    }
+    #if ENABLED(RAPIDIA_ISR_PROFILER)
+      else if (next_isr_ticks < min_ticks)
+        Rapidia::IsrProfiler::overrun();
+    #endif
 
     // Advance pulses if not enough time to wait for the next ISR
   } while (next_isr_ticks < min_ticks);
@@ -1495,6 +1539,8 @@ void Stepper::isr() {
   // Now 'next_isr_ticks' contains the period to the next Stepper ISR - And we are
   // sure that the time has not arrived yet - Warrantied by the scheduler
 
+  TERN_(RAPIDIA_ISR_PROFILER, Rapidia::IsrProfiler::record(Rapidia::ISR_PHASE_TOTAL, HAL_timer_get_count(STEP_TIMER_NUM) - isr_start));
+
   // Set the next ISR to fire at the proper time
   HAL_timer_set_compare(STEP_TIMER_NUM, hal_timer_t(next_isr_ticks));
 
@@ -1521,7 +1567,10 @@ void Stepper::pulse_phase_isr() {
   // If we must abort the current block, do so!
   if (abort_current_block) {
     abort_current_block = false;
-    if (current_block) discard_current_block();
+    if (current_block) {
+      TERN_(RAPIDIA_MILEAGE, mileage_tally_block(current_block->steps.e));
+      discard_current_block();
+    }
   }
 
   // If there is no current block, do nothing
@@ -1790,11 +1839,17 @@ uint32_t Stepper::block_phase_isr() {
   // If no queued movements, just wait 1ms for the next block
   uint32_t interval = (STEPPER_TIMER_RATE) / 1000UL;
 
+  #if ENABLED(RAPIDIA_STEPPER_PAUSE)
+    // A pause request is taken here, within a step of being made
+    if (pause_state == PAUSE_AT_LINE || pause_state == PAUSE_NOW) pause_phase();
+  #endif
+
   // If there is a current block
   if (current_block) {
 
     // If current block is finished, reset pointer and finalize state
-    if (step_events_completed >= step_event_count) {
+    // (unless a pause carries it on, to decelerate)
+    if (step_events_completed >= step_event_count && TERN1(RAPIDIA_STEPPER_PAUSE, (!pause_state || !pause_block_end()))) {
       #if ENABLED(DIRECT_STEPPING)
         #if STEPPER_PAGE_FORMAT == SP_4x4D_128
           #define PAGE_SEGMENT_UPDATE_POS(AXIS) \
@@ -1811,8 +1866,19 @@ uint32_t Stepper::block_phase_isr() {
           PAGE_SEGMENT_UPDATE_POS(E);
         }
       #endif
-      TERN_(HAS_FILAMENT_RUNOUT_DISTANCE, runout.block_completed(current_block));
-      discard_current_block();
+      #if ENABLED(RAPIDIA_STEPPER_PAUSE)
+        // (a block a pause decelerated on into is left in the buffer, as planned.)
+        if (pause_carried) {
+          current_block = nullptr;
+          axis_did_move = 0;
+        }
+        else
+      #endif
+      {
+        TERN_(HAS_FILAMENT_RUNOUT_DISTANCE, runout.block_completed(current_block));
+        TERN_(RAPIDIA_MILEAGE, mileage_tally_block(current_block->steps.e));
+        discard_current_block();
+      }
     }
     else {
       // Step events not completed yet...
@@ -1988,10 +2054,10 @@ uint32_t Stepper::block_phase_isr() {
 
   // If there is no current block at this point, attempt to pop one from the buffer
   // and prepare its movement
-  if (!current_block) {
+  if (!current_block && TERN1(RAPIDIA_STEPPER_PAUSE, pause_state < PAUSE_DECELERATING || pause_carry)) {
 
-    // Anything in the buffer?
-    if (current_block = planner.get_current_block()) {
+    // Anything in the buffer? (or the block a pause decelerates on into)
+    if (current_block = TERN(RAPIDIA_STEPPER_PAUSE, pause_next_block(), planner.get_current_block())) {
 
       // We have to skip certain types of blocks (blocks which don't contain motion)
       while (handle_non_motion_block(current_block))
@@ -2008,6 +2074,15 @@ uint32_t Stepper::block_phase_isr() {
         return interval;
       }
 
+      #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+        // the moving carriage's blocks (and another carriage move) wait for it to stop.
+        if (carriage_moving && (TEST(current_block->flag, BLOCK_BIT_CARRIAGE) || current_block->extruder == carriage_move.carriage))
+        {
+          current_block = nullptr;
+          return interval;
+        }
+      #endif
+
       // For non-inline cutter, grossly apply power
       #if ENABLED(LASER_FEATURE) && DISABLED(LASER_POWER_INLINE)
         cutter.apply_power(current_block->cutter_power);
@@ -2238,6 +2313,9 @@ uint32_t Stepper::block_phase_isr() {
 
       // Calculate the initial timer interval
       interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr);
+
+      // Nothing is extruded while pausing
+      TERN_(RAPIDIA_STEPPER_PAUSE, if (pause_state) pause_phase());
     }
     #if ENABLED(LASER_POWER_INLINE_CONTINUOUS)
       else { // No new block found; so apply inline laser parameters
@@ -2260,10 +2338,27 @@ uint32_t Stepper::block_phase_isr() {
   return interval;
 }
 
+#if ENABLED(RAPIDIA_MILEAGE)
+  // adds the current block's E steps to the mileage tally.
+  // (if the block ends early, only the part executed so far counts.)
+  void Stepper::mileage_tally_block(uint32_t e_steps) {
+    if (step_events_completed < step_event_count)
+      e_steps = uint64_t(e_steps) * step_events_completed / step_event_count;
+    const int32_t signed_steps = TEST(current_block->direction_bits, E_AXIS) ? -int32_t(e_steps) : int32_t(e_steps);
+    Rapidia::mileage.increment_e_steps_tally(current_block->extruder, signed_steps);
+  }
+#endif
+
 void Stepper::stop_e_motion()
 {
   const bool was_enabled = suspend();
 
+  #if ENABLED(RAPIDIA_MILEAGE)
+    // the planner has already cleared steps.e for this block,
+    // so count the E steps taken so far from what the ISR started with.
+    if (current_block) mileage_tally_block(advance_dividend.e >> 1);
+  #endif
+
   advance_dividend.e = 0;
 
   // optimization: skip this block if it's pure-extrude
@@ -2276,6 +2371,193 @@ void Stepper::stop_e_motion()
   if (was_enabled) wake_up();
 }
 
+#if ENABLED(RAPIDIA_STEPPER_PAUSE)
+
+  // As slow as the planner ends a block (MINIMAL_STEP_RATE)
+  static constexpr uint32_t pause_stop_rate = 120;
+
+  // Steps to decelerate from rate to pause_stop_rate at accel (steps/s^2): (v^2 - s^2) / 2a, rounded up.
+  static uint32_t pause_stop_steps(const uint32_t rate, const uint32_t accel) {
+    const uint32_t accel_x2 = accel * 2;
+    if (rate <= pause_stop_rate || !accel_x2) return 0;
+    if (rate > 0xFFFF)
+      return (sq(uint64_t(rate)) - sq(pause_stop_rate) + accel_x2 - 1) / accel_x2;
+    const uint32_t dv = sq(rate) - sq(pause_stop_rate);
+    return dv / accel_x2 + (dv % accel_x2 != 0);
+  }
+
+  void Stepper::pause(const bool hard) {
+    if (pause_state == PAUSE_NONE) {
+      pause_info.request_us = micros();
+      pause_info.line = NO_SOURCE_LINE;
+      pause_info.decelerated = false;
+      TERN_(RAPIDIA_PAUSE_RESUME, pause_info.resumable = true);
+      pause_taken = false;
+      pause_carry = nullptr;
+      pause_state = hard ? PAUSE_NOW : PAUSE_AT_LINE;
+    }
+    else if (hard && pause_state == PAUSE_AT_LINE) {
+      // (the soft pause has already stopped extrusion short of where this one stops.)
+      TERN_(RAPIDIA_PAUSE_RESUME, if (pause_taken) pause_info.resumable = false);
+      pause_state = PAUSE_NOW;
+    }
+  }
+
+  /**
+   * Called from block_phase_isr() while a pause is requested, and when a block is taken.
+   * Stops extrusion at once, and stops a hard pause from the current step.
+   */
+  void Stepper::pause_phase() {
+    if (!pause_taken) {
+      pause_info.position = count_position;
+      pause_taken = true;
+
+      #if ENABLED(RAPIDIA_PAUSE_RESUME)
+        // What the interrupted block has left to extrude, for R754
+        pause_info.hard = pause_state == PAUSE_NOW;
+        pause_info.interrupted = current_block;
+        if (current_block) {
+          const uint32_t e = current_block->steps.e,
+                         left = e - uint32_t(uint64_t(e) * step_events_completed / step_event_count);
+          pause_info.e_remaining = TEST(current_block->direction_bits, E_AXIS) ? -int32_t(left) : int32_t(left);
+          pause_info.nominal_speed_sqr = current_block->nominal_speed_sqr;
+          pause_info.interrupted_line = current_block->source_line;
+        }
+      #endif
+    }
+
+    if (!current_block) {
+      // (a soft pause waits for more blocks, unless there are none to come.)
+      if (pause_state == PAUSE_NOW || !planner.has_blocks_queued()) {
+        pause_info.decelerate_from = count_position;
+        pause_stop();
+      }
+      return;
+    }
+
+    if (advance_dividend.e) {
+      // (a block decelerated on into keeps its extrusion, for R754.)
+      if (!pause_carried) {
+        TERN_(RAPIDIA_MILEAGE, mileage_tally_block(advance_dividend.e >> 1));
+        current_block->steps.e = 0;
+      }
+      advance_dividend.e = 0;
+
+      // (an extrusion-only block is left with nothing to do.)
+      if (!advance_dividend.a && !advance_dividend.b && !advance_dividend.c) step_events_completed = step_event_count;
+    }
+
+    // (a block that has just finished decelerates in pause_block_end().)
+    if (pause_state == PAUSE_NOW && step_events_completed < step_event_count)
+      pause_decelerate();
+    else if (pause_carried)
+      pause_slow(current_block->initial_rate);
+  }
+
+  /**
+   * Called as a block finishes while a pause is under way. Returns true if the block carries on, to decelerate.
+   * Still too fast to stop, the deceleration carries on into the next block if it's ready (with the rate the
+   * planner would take the junction at) or else past this block's end, along its line.
+   */
+  bool Stepper::pause_block_end() {
+    // (a pause requested since block_phase_isr() checked for one is taken here, before the block ends.)
+    if (!pause_taken) pause_phase();
+    if (pause_state == PAUSE_AT_LINE) {
+      if (current_block->source_line == NO_SOURCE_LINE) return false;
+      pause_info.line = current_block->source_line;
+    }
+    if (pause_state != PAUSE_DECELERATING) pause_decelerate();
+
+    const uint32_t rate = pause_rate();
+    if (rate > pause_stop_rate) {
+      if ((pause_carry = planner.pause_carry_block(current_block))) {
+        // (in proportion to the rates the planner took the junction at, either side.)
+        pause_carry->initial_rate = uint64_t(rate) * pause_carry->initial_rate / _MAX(rate, pause_exit_rate);
+        pause_info.decelerated = true;
+        return false;
+      }
+      if (pause_extend(rate)) return true;
+    }
+    pause_stop();
+    return false;
+  }
+
+  // Decelerates to a stop from the current step of the current block.
+  void Stepper::pause_decelerate() {
+    pause_info.decelerate_from = count_position;
+    pause_state = PAUSE_DECELERATING;
+    pause_slow(pause_rate());
+  }
+
+  // The rate the current block is stepping at, from its trapezoid phase. (an extrusion-only block just ends.)
+  uint32_t Stepper::pause_rate() {
+    if (!advance_dividend.a && !advance_dividend.b && !advance_dividend.c) return 0;
+    if (step_events_completed <= accelerate_until) return acc_step_rate;
+    if (step_events_completed > decelerate_after) {
+      const uint32_t slowed = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
+      return slowed < acc_step_rate ? _MAX(acc_step_rate - slowed, current_block->final_rate) : current_block->final_rate;
+    }
+    return current_block->nominal_rate;
+  }
+
+  // Decelerates the current block from rate, from the next step event, at its acceleration:
+  // cutting it short, or over the rest of it if there isn't room (see pause_block_end()).
+  void Stepper::pause_slow(const uint32_t rate) {
+    const uint32_t steps = pause_stop_steps(rate, current_block->acceleration_steps_per_s2),
+                   left = step_events_completed < step_event_count ? (step_event_count - step_events_completed) >> oversampling_factor : 0;
+    if (steps < left) step_event_count = step_events_completed + (steps << oversampling_factor);
+    if (steps && left) pause_info.decelerated = true;
+
+    accelerate_until = 0;
+    decelerate_after = step_events_completed ? step_events_completed - 1 : 0;
+    acc_step_rate = rate;
+    deceleration_time = 0;
+    pause_exit_rate = current_block->final_rate;
+    current_block->final_rate = pause_stop_rate;
+  }
+
+  /**
+   * Carries the current block on past its end, along the same line, to finish decelerating. (extending the
+   * step event count keeps the Bresenham tracer on the line.) It goes no further than the soft endstops,
+   * which keep X clear of the other carriage, and stops short at them. Returns false if there's no room.
+   */
+  bool Stepper::pause_extend(const uint32_t rate) {
+    uint32_t steps = pause_stop_steps(rate, current_block->acceleration_steps_per_s2);
+
+    #if HAS_SOFTWARE_ENDSTOPS
+      LOOP_XYZ(axis) {
+        const uint32_t axis_steps = current_block->steps[axis];
+        // (X stays clear of the other carriage with soft endstops off.)
+        if (!axis_steps || !(soft_endstops_enabled || (ENABLED(DUAL_X_CARRIAGE) && axis == X_AXIS))) continue;
+        const float limit = count_direction[axis] > 0 ? soft_endstop.max[axis] : soft_endstop.min[axis];
+        const int32_t room = (int32_t(limit * planner.settings.axis_steps_per_mm[axis]) - count_position[axis]) * count_direction[axis];
+        if (room <= 0) return false;
+        NOMORE(steps, uint64_t(room) * current_block->step_event_count / axis_steps);
+      }
+    #endif
+
+    if (!steps) return false;
+    step_event_count += steps << oversampling_factor;
+    pause_info.decelerated = true;
+    return true;
+  }
+
+  // The block to take: the one the deceleration carries on into (which is left in the buffer), or the planner's.
+  block_t* Stepper::pause_next_block() {
+    pause_carried = pause_carry != nullptr;
+    if (!pause_carried) return planner.get_current_block();
+    block_t * const block = pause_carry;
+    pause_carry = nullptr;
+    return block;
+  }
+
+  void Stepper::pause_stop() {
+    pause_info.stop_us = micros();
+    pause_state = PAUSE_STOPPED;
+  }
+
+#endif // RAPIDIA_STEPPER_PAUSE
+
 #if ENABLED(LIN_ADVANCE)
 
   // Timer interrupt for E. LA_steps is set in the main routine
@@ -2375,6 +2657,104 @@ void Stepper::stop_e_motion()
 
 #endif // LIN_ADVANCE
 
+#if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+
+  // sets up the idle carriage's move from its block, unless it's still moving.
+  bool Stepper::start_carriage_move(const block_t * const block)
+  {
+    if (carriage_moving) return false;
+
+    carriage_move_t &m = carriage_move;
+    const bool reverse = TEST(block->direction_bits, X_AXIS);
+    m.carriage = block->extruder;
+    m.direction = reverse ? -1 : 1;
+    m.step_event_count = block->step_event_count;
+    m.position = block->position.x - m.direction * int32_t(m.step_event_count);
+    m.steps_completed = 0;
+    m.accelerate_until = block->accelerate_until;
+    m.decelerate_after = block->decelerate_after;
+    m.acceleration_rate = block->acceleration_rate;
+    m.initial_rate = m.cruise_rate = block->initial_rate;
+    m.nominal_rate = block->nominal_rate;
+    m.acceleration_time = m.deceleration_time = 0;
+
+    // the active carriage's blocks never set the idle carriage's direction.
+    DIR_WAIT_BEFORE();
+    const bool dir = reverse ? INVERT_X_DIR : !INVERT_X_DIR;
+    if (m.carriage) X2_DIR_WRITE(dir); else X_DIR_WRITE(dir);
+    DIR_WAIT_AFTER();
+
+    carriage_moves_taken++;
+    carriage_moving = true;
+    nextCarriageISR = 0;
+    return true;
+  }
+
+  // Timer interrupt for the idle X carriage: one step per call, on its own trapezoid.
+  uint32_t Stepper::carriage_isr()
+  {
+    if (!carriage_moving) return CARRIAGE_NEVER;
+
+    carriage_move_t &m = carriage_move;
+
+    #if ISR_PULSE_CONTROL
+      USING_TIMED_PULSE();
+    #endif
+
+    if (m.carriage) X2_STEP_WRITE(!INVERT_X_STEP_PIN); else X_STEP_WRITE(!INVERT_X_STEP_PIN);
+
+    #if ISR_PULSE_CONTROL
+      START_HIGH_PULSE();
+    #endif
+
+    m.position += m.direction;
+    const uint32_t completed = ++m.steps_completed;
+
+    #if ISR_PULSE_CONTROL
+      AWAIT_HIGH_PULSE();
+    #endif
+
+    if (m.carriage) X2_STEP_WRITE(INVERT_X_STEP_PIN); else X_STEP_WRITE(INVERT_X_STEP_PIN);
+
+    if (completed >= m.step_event_count)
+    {
+      carriage_moving = false;
+      return CARRIAGE_NEVER;
+    }
+
+    uint32_t step_rate;
+    uint8_t loops;
+    if (completed <= m.accelerate_until)
+    {
+      step_rate = STEP_MULTIPLY(m.acceleration_time, m.acceleration_rate) + m.initial_rate;
+      NOMORE(step_rate, m.nominal_rate);
+      m.cruise_rate = step_rate;
+      const uint32_t interval = calc_timer_interval(step_rate, &loops);
+      m.acceleration_time += interval;
+      return interval;
+    }
+    else if (completed > m.decelerate_after)
+    {
+      step_rate = STEP_MULTIPLY(m.deceleration_time, m.acceleration_rate);
+      step_rate = step_rate < m.cruise_rate ? _MAX(m.cruise_rate - step_rate, m.initial_rate) : m.initial_rate;
+      const uint32_t interval = calc_timer_interval(step_rate, &loops);
+      m.deceleration_time += interval;
+      return interval;
+    }
+
+    m.cruise_rate = m.nominal_rate;
+    return calc_timer_interval(m.nominal_rate, &loops);
+  }
+
+  int32_t Stepper::carriage_stop()
+  {
+    carriage_moving = false;
+    nextCarriageISR = CARRIAGE_NEVER;
+    return carriage_move.position;
+  }
+
+#endif // RAPIDIA_IDLE_CARRIAGE
+
 #if ENABLED(INTEGRATED_BABYSTEPPING)
 
   // Timer interrupt for baby-stepping
@@ -2625,6 +3005,13 @@ FORCE_INLINE bool Stepper::handle_non_motion_block(const block_t* block)
     return false;
   }
   else if (TEST(block->flag, BLOCK_BIT_SYNC_POSITION)) {
+    #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+      // a move of the idle carriage, which isn't taken while the last is being stepped.
+      if (TEST(block->flag, BLOCK_BIT_CARRIAGE) && block->step_event_count)
+      {
+        return start_carriage_move(block);
+      }
+    #endif
     // this is a sync block
     _set_position(block->position);
     return true;
@@ -335,6 +335,29 @@ class Stepper {
       static uint32_t nextBabystepISR;
     #endif
 
+    #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+      // A move of the idle X carriage (R762), stepped alongside the current block.
+      typedef struct {
+        uint8_t carriage;           // Which carriage (0 = X, 1 = X2)
+        int8_t direction;           // +1 or -1
+        int32_t position;           // The carriage's position, in steps
+        uint32_t step_event_count,  // Steps in the move
+                 steps_completed,
+                 accelerate_until,
+                 decelerate_after,
+                 acceleration_rate, // (as block_t)
+                 initial_rate,
+                 nominal_rate,
+                 cruise_rate,       // Rate deceleration starts from
+                 acceleration_time,
+                 deceleration_time;
+      } carriage_move_t;
+
+      static constexpr uint32_t CARRIAGE_NEVER = 0xFFFFFFFF;
+      static uint32_t nextCarriageISR;
+      static carriage_move_t carriage_move;
+    #endif
+
     #if ENABLED(DIRECT_STEPPING)
       static page_step_state_t page_step_state;
     #endif
@@ -405,6 +428,19 @@ class Stepper {
       FORCE_INLINE static void initiateLA() { nextAdvanceISR = 0; }
     #endif
 
+    #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+      // The idle carriage ISR phase
+      static uint32_t carriage_isr();
+
+      // Moves taken (started) by the ISR, and whether the last is being stepped.
+      static volatile uint8_t carriage_moves_taken;
+      static volatile bool carriage_moving;
+
+      // Ends the idle carriage's move where it is (with the ISR suspended),
+      // and returns its position in steps.
+      static int32_t carriage_stop();
+    #endif
+
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       // The Babystepping ISR phase
       static uint32_t babystepping_isr();
@@ -452,6 +488,45 @@ class Stepper {
 
     static void stop_e_motion();
 
+    #if ENABLED(RAPIDIA_STEPPER_PAUSE)
+      // a pause carried out by the stepper ISR (R751/R752), rather than by replanning.
+      enum PauseState : uint8_t {
+        PAUSE_NONE,
+        PAUSE_AT_LINE,      // requested: decelerate at the end of the next block marked with a source line
+        PAUSE_NOW,          // requested: decelerate from the current step
+        PAUSE_DECELERATING, // slowing to a stop over the current block and those after it (or past its end, along its line)
+        PAUSE_STOPPED       // at rest. no more blocks are taken until pause_release()
+      };
+
+      typedef struct {
+        xyze_long_t position;       // steppers when the ISR took the request
+        xyz_long_t decelerate_from; // steppers when deceleration began
+        source_line_t line;         // marked block the pause stopped after (soft), or NO_SOURCE_LINE
+        uint32_t request_us,        // when the pause was requested
+                 stop_us;           // when the steppers came to rest
+        bool decelerated;           // whether any steps were taken decelerating
+        #if ENABLED(RAPIDIA_PAUSE_RESUME)
+          bool hard,                // the request was hard when the ISR took it
+               resumable,           // (not if a soft pause was made hard after the ISR took it)
+               interrupted;         // a block was being stepped when the ISR took the request
+          source_line_t interrupted_line; // that block's source line (if it's the last of its gcode)
+          int32_t e_remaining;      // E steps it had left to extrude
+          float nominal_speed_sqr;  // its nominal speed
+        #endif
+      } pause_info_t;
+
+      static volatile PauseState pause_state;
+      static pause_info_t pause_info;
+
+      // requests a pause, from any context (e.g. the emergency parser.)
+      // a hard request overrides a soft one.
+      static void pause(const bool hard);
+      FORCE_INLINE static bool pause_stopped() { return pause_state == PAUSE_STOPPED; }
+
+      // lets the ISR take blocks again, once the planner has dealt with those left behind.
+      FORCE_INLINE static void pause_release() { pause_state = PAUSE_NONE; }
+    #endif
+
     // Quickly stop all steppers
     FORCE_INLINE static void quick_stop() { abort_current_block = true; }
 
@@ -530,6 +605,29 @@ class Stepper {
 
     static bool handle_non_motion_block(const block_t* block);
 
+    #if ENABLED(RAPIDIA_MILEAGE)
+      static void mileage_tally_block(uint32_t e_steps);
+    #endif
+
+    #if ENABLED(RAPIDIA_STEPPER_PAUSE)
+      static bool pause_taken;
+      static block_t* pause_carry;      // the next block, for the deceleration to carry on into
+      static bool pause_carried;        // the current block is one it carried on into (left in the buffer)
+      static uint32_t pause_exit_rate;  // the current block's planned final rate
+      static void pause_phase();
+      static bool pause_block_end();
+      static void pause_decelerate();
+      static uint32_t pause_rate();
+      static void pause_slow(const uint32_t rate);
+      static bool pause_extend(const uint32_t rate);
+      static block_t* pause_next_block();
+      static void pause_stop();
+    #endif
+
+    #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+      static bool start_carriage_move(const block_t * const block);
+    #endif
+
     // Set the current position in steps
     static void _set_position(const int32_t &a, const int32_t &b, const int32_t &c, const int32_t &e);
     FORCE_INLINE static void _set_position(const abce_long_t &spos) { _set_position(spos.a, spos.b, spos.c, spos.e); }
@@ -826,10 +826,97 @@ void Temperature::min_temp_error(const heater_ind_t heater) {
     extern bool pid_debug_flag;
   #endif
 
+  #if ENABLED(RAPIDIA_FIXED_PID)
+
+    /**
+     * The hotend PID gains in fixed point, for temperatures in 1/256ths of a degree and output in
+     * 1/256ths of a PWM step: Kp and Kd in 1/16ths, and Ki in 1/4096ths. i_max limits the integral,
+     * and d_max the temperature change the D term is taken over (beyond which it saturates).
+     */
+    typedef struct { int32_t Kp, Ki, Kd, i_max, d_max; } fixed_pid_t;
+    static fixed_pid_t fixed_pid[HOTENDS];
+
+    // (the D term's smoothing, in 1/4096ths)
+    static constexpr int32_t fixed_pid_k2 = int32_t(PID_K2 * 4096 + 0.5f);
+
+    // (a D term past 16384 PWM steps is a sensor glitch; the limit keeps its smoothing within 32 bits.)
+    #define FIXED_PID_D_LIMIT (16384L << 8)
+
+    void Temperature::update_fixed_pid() {
+      HOTEND_LOOP() {
+        fixed_pid_t &f = fixed_pid[e];
+        f.Kp = LROUND(PID_PARAM(Kp, e) * 16);
+        f.Ki = LROUND(PID_PARAM(Ki, e) * 4096);
+        f.Kd = LROUND(PID_PARAM(Kd, e) * 16);
+        // (a gain under 1/4096 adds nothing, as the float PID's would add next to nothing.)
+        f.i_max = f.Ki > 0 ? LROUND((float(PID_MAX) / PID_PARAM(Ki, e) - float(MIN_POWER)) * 256) : 0;
+        f.d_max = f.Kd > 0 ? (FIXED_PID_D_LIMIT << 4) / f.Kd : FIXED_PID_D_LIMIT;
+      }
+    }
+
+  #endif
+
   float Temperature::get_pid_output_hotend(const uint8_t E_NAME) {
     const uint8_t ee = HOTEND_INDEX;
     #if ENABLED(PIDTEMP)
-      #if DISABLED(PID_OPENLOOP)
+      #if BOTH(RAPIDIA_FIXED_PID, PID_DEBUG) && DISABLED(PID_OPENLOOP)
+        static hotend_pid_t work_pid[HOTENDS];
+      #endif
+      #if ENABLED(PID_OPENLOOP)
+
+        const float pid_output = constrain(temp_hotend[ee].target, 0, PID_MAX);
+
+      #elif ENABLED(RAPIDIA_FIXED_PID)
+
+        // (in 1/256ths of a degree, and of a PWM step)
+        static int32_t temp_iState[HOTENDS] = { 0 },
+                       temp_dState[HOTENDS] = { 0 },
+                       work_Kd[HOTENDS] = { 0 };
+        static bool pid_reset[HOTENDS] = { false };
+        const fixed_pid_t &pid = fixed_pid[ee];
+        const int32_t celsius = int32_t(temp_hotend[ee].celsius * 256),
+                      pid_error = int32_t(temp_hotend[ee].target) * 256 - celsius;
+
+        int32_t pid_output;
+
+        if (temp_hotend[ee].target == 0
+          || pid_error < -(PID_FUNCTIONAL_RANGE) * 256L
+          || TERN0(HEATER_IDLE_HANDLER, hotend_idle[ee].timed_out)
+        ) {
+          pid_output = 0;
+          pid_reset[ee] = true;
+        }
+        else if (pid_error > (PID_FUNCTIONAL_RANGE) * 256L) {
+          pid_output = BANG_MAX;
+          pid_reset[ee] = true;
+        }
+        else {
+          if (pid_reset[ee]) {
+            temp_iState[ee] = 0;
+            work_Kd[ee] = 0;
+            pid_reset[ee] = false;
+          }
+
+          const int32_t d_term = (constrain(temp_dState[ee] - celsius, -pid.d_max, pid.d_max) * pid.Kd) >> 4;
+          work_Kd[ee] += ((d_term - work_Kd[ee]) * fixed_pid_k2) >> 12;
+          temp_iState[ee] = constrain(temp_iState[ee] + pid_error, 0, pid.i_max);
+          const int32_t p_term = (pid_error * pid.Kp) >> 4,
+                        i_term = (temp_iState[ee] * pid.Ki) >> 12;
+
+          pid_output = p_term + i_term + work_Kd[ee] + int32_t(MIN_POWER) * 256;
+          LIMIT(pid_output, 0, int32_t(PID_MAX) * 256);
+          pid_output >>= 8;
+
+          #if ENABLED(PID_DEBUG)
+            work_pid[ee].Kp = p_term * (1.0f / 256);
+            work_pid[ee].Ki = i_term * (1.0f / 256);
+            work_pid[ee].Kd = work_Kd[ee] * (1.0f / 256);
+          #endif
+        }
+        temp_dState[ee] = celsius;
+
+      #else
+
         static hotend_pid_t work_pid[HOTENDS];
         static float temp_iState[HOTENDS] = { 0 },
                      temp_dState[HOTENDS] = { 0 };
@@ -897,11 +984,7 @@ void Temperature::min_temp_error(const heater_ind_t heater) {
         }
         temp_dState[ee] = temp_hotend[ee].celsius;
 
-      #else // PID_OPENLOOP
-
-        const float pid_output = constrain(temp_hotend[ee].target, 0, PID_MAX);
-
-      #endif // PID_OPENLOOP
+      #endif // !PID_OPENLOOP && !RAPIDIA_FIXED_PID
 
       #if ENABLED(PID_DEBUG)
         if (ee == active_extruder && pid_debug_flag) {
@@ -308,6 +308,13 @@ typedef struct { int16_t raw_min, raw_max, mintemp, maxtemp; } temp_range_t;
 
 class Temperature {
 
+  #ifdef __PLAT_LINUX__
+    // the simulator's --bench-heater (HAL/LINUX/heater_bench.cpp) hands manage_heater() raw readings,
+    // which only the temperature ISR does (raw_temps_ready), and calls get_pid_output_hotend() on its
+    // own, to compare it against float without manage_heater()'s halved PWM and thermal protection.
+    friend int bench_heater(const uint32_t calls);
+  #endif
+
   public:
 
     #if HAS_HOTEND
@@ -731,6 +738,7 @@ class Temperature {
       #if ENABLED(PIDTEMP)
         FORCE_INLINE static void updatePID() {
           TERN_(PID_EXTRUSION_SCALING, last_e_position = 0);
+          TERN_(RAPIDIA_FIXED_PID, update_fixed_pid());
         }
       #endif
 
@@ -804,6 +812,9 @@ class Temperature {
 
     static float get_pid_output_hotend(const uint8_t e);
 
+    // converts the hotend PID gains for the fixed-point PID.
+    TERN_(RAPIDIA_FIXED_PID, static void update_fixed_pid());
+
     TERN_(PIDTEMPBED, static float get_pid_output_bed());
 
     TERN_(HAS_HEATED_CHAMBER, static float get_pid_output_chamber());
@@ -725,6 +725,8 @@ inline void fast_line_to_current(const AxisEnum fr_axis) { _line_to_current(fr_a
       planner.synchronize();
     }
 
+    const float old_x = current_position.x;
+
     // Activate the new extruder ahead of calling set_axis_is_at_home!
     active_extruder = new_tool;
 
@@ -741,6 +743,8 @@ inline void fast_line_to_current(const AxisEnum fr_axis) { _line_to_current(fr_a
         inactive_extruder_x_pos = destination.x;
         break;
       case DXC_AUTO_PARK_MODE:
+        // the old carriage is parked (or left where it was), which limits the new one
+        inactive_extruder_x_pos = old_x;
         // record current raised toolhead position for use by unpark
         raised_parked_position = current_position;
         active_extruder_parked = true;
@@ -754,6 +758,95 @@ inline void fast_line_to_current(const AxisEnum fr_axis) { _line_to_current(fr_a
     DEBUG_POS("New extruder (parked)", current_position);
   }
 
+  #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+
+    /**
+     * A full control mode tool change which doesn't wait for the old tool's moves.
+     * The carriages swap at a sync block, and the stepper ISR holds the new tool's
+     * blocks while its carriage finishes any R762 move.
+     */
+    inline void dualx_parallel_tool_change(const uint8_t new_tool) {
+      const uint8_t old_tool = active_extruder;
+
+      // the physical position, as leveling is turned off for a tool change (which would synchronize)
+      planner.apply_leveling(current_position);
+
+      destination = current_position;
+      dualx_tool_change(new_tool, true);
+
+      xyz_pos_t diff = hotend_offset[new_tool] - hotend_offset[old_tool];
+      diff.x = 0;
+      DEBUG_ECHOLNPAIR("Offset Tool XYZ by { ", diff.x, ", ", diff.y, ", ", diff.z, " }");
+      current_position += diff;
+
+      planner.unapply_leveling(current_position);
+
+      planner.carriage_swap = true;
+      sync_plan_position();
+      planner.carriage_swap = false;
+
+      active_extruder_parked = false;
+      update_software_endstops(X_AXIS, old_tool, new_tool);
+    }
+
+  #endif
+
+  #if ENABLED(RAPIDIA_QUEUED_TOOL_CHANGE)
+
+    /**
+     * An auto-park mode tool change buffered behind the old tool's moves: raise, park the
+     * old carriage, swap carriages at a sync block and unpark the new one, with no
+     * synchronize before or after. (leveling stays on, as turning it off would synchronize.)
+     */
+    inline void dualx_queued_tool_change(const uint8_t new_tool) {
+      const uint8_t old_tool = active_extruder;
+      destination = current_position;
+
+      #if HAS_SOFTWARE_ENDSTOPS
+        // we temporarily allow motion to be unconstrained during the tool change.
+        soft_endstop.min.x = X1_MIN_POS;
+        soft_endstop.max.x = X2_MAX_POS;
+      #endif
+
+      // Do a small lift to avoid the workpiece, and park the old head
+      current_position.z += toolchange_settings.z_raise;
+      #if HAS_SOFTWARE_ENDSTOPS
+        NOMORE(current_position.z, soft_endstop.max.z);
+      #endif
+      fast_line_to_current(Z_AXIS);
+      current_position.x = x_home_pos(old_tool);
+      fast_line_to_current(X_AXIS);
+
+      // the physical position, so the offsets apply as they would with leveling off
+      planner.apply_leveling(current_position);
+
+      dualx_tool_change(new_tool, true);
+
+      xyz_pos_t diff = hotend_offset[new_tool] - hotend_offset[old_tool];
+      diff.x = 0;
+      DEBUG_ECHOLNPAIR("Offset Tool XYZ by { ", diff.x, ", ", diff.y, ", ", diff.z, " }");
+      current_position += diff;
+
+      planner.unapply_leveling(current_position);
+
+      planner.carriage_swap = true;
+      sync_plan_position();
+      planner.carriage_swap = false;
+
+      // Move back to the original (or adjusted) position
+      apply_motion_limits(destination);
+      DEBUG_POS("Move back", destination);
+      current_position.set(destination.x, destination.y);
+      fast_line_to_current(X_AXIS);
+      current_position.z = destination.z;
+      fast_line_to_current(Z_AXIS);
+
+      active_extruder_parked = false;
+      update_software_endstops(X_AXIS, old_tool, new_tool);
+    }
+
+  #endif
+
 #endif // DUAL_X_CARRIAGE
 
 /**
@@ -872,6 +965,30 @@ void tool_change(const uint8_t new_tool, bool no_move/*=false*/) {
 
   #else // EXTRUDERS > 1
 
+    #if ENABLED(RAPIDIA_IDLE_CARRIAGE)
+      if (dual_x_carriage_mode == DXC_FULL_CONTROL_MODE && new_tool < EXTRUDERS) {
+        if (new_tool != active_extruder) dualx_parallel_tool_change(new_tool);
+        SERIAL_ECHO_START();
+        SERIAL_ECHOLNPAIR(STR_ACTIVE_EXTRUDER, int(active_extruder));
+        return;
+      }
+    #endif
+
+    #if ENABLED(RAPIDIA_QUEUED_TOOL_CHANGE)
+      if (dual_x_carriage_mode == DXC_AUTO_PARK_MODE && new_tool < EXTRUDERS
+          && !no_move && IsRunning() && !homing_needed()
+      ) {
+        if (new_tool != active_extruder) dualx_queued_tool_change(new_tool);
+        #ifdef EVENT_GCODE_AFTER_TOOLCHANGE
+          // (its moves are buffered behind the tool change.)
+          gcode.process_subcommands_now_P(PSTR(EVENT_GCODE_AFTER_TOOLCHANGE));
+        #endif
+        SERIAL_ECHO_START();
+        SERIAL_ECHOLNPAIR(STR_ACTIVE_EXTRUDER, int(active_extruder));
+        return;
+      }
+    #endif
+
     planner.synchronize();
 
     #if ENABLED(DUAL_X_CARRIAGE)  // Only T0 allowed if the Printer is in DXC_DUPLICATION_MODE or DXC_MIRRORED_MODE
@@ -118,6 +118,13 @@ char CardReader::proc_filenames[SD_PROCEDURE_DEPTH][MAXPATHNAMELENGTH];
 
 uint32_t CardReader::filesize, CardReader::sdpos;
 
+#if ENABLED(RAPIDIA_SD_READ_AHEAD)
+  char CardReader::ahead_buffer[2][RAPIDIA_SD_READ_AHEAD_SIZE];
+  uint16_t CardReader::ahead_len[2];
+  uint8_t CardReader::ahead_r, CardReader::ahead_count;
+  uint16_t CardReader::ahead_offset;
+#endif
+
 CardReader::CardReader() {
   #if ENABLED(SDCARD_SORT_ALPHA)
     sort_count = 0;
@@ -565,6 +572,7 @@ void CardReader::openFileRead(char * const path, const uint8_t subcall_type/*=0*
   if (file.open(curDir, fname, O_READ)) {
     filesize = file.fileSize();
     sdpos = 0;
+    TERN_(RAPIDIA_SD_READ_AHEAD, discard_read_ahead());
 
     PORT_REDIRECT(SERIAL_BOTH);
     SERIAL_ECHOLNPAIR(STR_SD_FILE_OPENED, fname, STR_SD_SIZE, filesize);
@@ -632,6 +640,7 @@ void CardReader::removeFile(const char * const name) {
     if (file.remove(curDir, fname)) {
       SERIAL_ECHOLNPAIR("File deleted:", fname);
       sdpos = 0;
+      TERN_(RAPIDIA_SD_READ_AHEAD, discard_read_ahead());
       TERN_(SDCARD_SORT_ALPHA, presort());
     }
     else
@@ -639,6 +648,40 @@ void CardReader::removeFile(const char * const name) {
   #endif
 }
 
+#if ENABLED(RAPIDIA_SD_READ_AHEAD)
+
+  /**
+   * Read the next buffer from the file. The file position is
+   * always at the end of the buffers read so far.
+   * Return false on a read error, or if there's nothing to read.
+   */
+  bool CardReader::fill_read_ahead() {
+    if (ahead_count >= 2 || !isFileOpen()) return false;
+    const uint8_t w = ahead_r ^ ahead_count;
+    const int16_t n = file.read(ahead_buffer[w], RAPIDIA_SD_READ_AHEAD_SIZE);
+    if (n <= 0) return false;
+    ahead_len[w] = n;
+    ahead_count++;
+    return true;
+  }
+
+  /**
+   * Read ahead (one buffer per call) while printing.
+   */
+  void CardReader::read_ahead() {
+    if (isPrinting() && ahead_count < 2 && file.curPosition() < filesize)
+      fill_read_ahead();
+  }
+
+  int16_t CardReader::read_span(const char* &p) {
+    if (!ahead_count && (eof() || !fill_read_ahead()))
+      return eof() ? 0 : -1;
+    p = ahead_buffer[ahead_r] + ahead_offset;
+    return ahead_len[ahead_r] - ahead_offset;
+  }
+
+#endif // RAPIDIA_SD_READ_AHEAD
+
 void CardReader::report_status() {
   if (isPrinting()) {
     SERIAL_ECHOPGM(STR_SD_PRINTING_BYTE);
@@ -710,6 +753,7 @@ void CardReader::closefile(const bool store_location) {
   file.close();
   flag.saving = flag.logging = false;
   sdpos = 0;
+  TERN_(RAPIDIA_SD_READ_AHEAD, discard_read_ahead());
   #if DISABLED(RAPIDIA)
     TERN_(EMERGENCY_PARSER, emergency_parser.enable());
   #endif
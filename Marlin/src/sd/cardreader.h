@@ -158,10 +158,30 @@ public:
   static inline uint32_t getIndex() { return sdpos; }
   static inline uint32_t getFileSize() { return filesize; }
   static inline bool eof() { return sdpos >= filesize; }
-  static inline void setIndex(const uint32_t index) { sdpos = index; file.seekSet(index); }
+  static inline void setIndex(const uint32_t index) { sdpos = index; file.seekSet(index); TERN_(RAPIDIA_SD_READ_AHEAD, discard_read_ahead()); }
   static inline char* getWorkDirName() { workDir.getDosName(filename); return filename; }
-  static inline int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
-  static inline int16_t read(void* buf, uint16_t nbyte) { return file.isOpen() ? file.read(buf, nbyte) : -1; }
+  static inline int16_t get() { TERN_(RAPIDIA_SD_READ_AHEAD, sync_read_ahead()); sdpos = file.curPosition(); return (int16_t)file.read(); }
+  static inline int16_t read(void* buf, uint16_t nbyte) { TERN_(RAPIDIA_SD_READ_AHEAD, sync_read_ahead()); return file.isOpen() ? file.read(buf, nbyte) : -1; }
+
+  #if ENABLED(RAPIDIA_SD_READ_AHEAD)
+    /**
+     * Buffered reads, for printing. The file is read ahead into two buffers, from idle(),
+     * while the queue is busy. read_span points p at the next unread bytes and returns how
+     * many follow contiguously (reading a buffer now if none is ready), or 0 at the end of
+     * the file or on a read error (-1). consume(n) moves sdpos past n of them, so sdpos is
+     * always the exact position of the next unread byte.
+     */
+    static void read_ahead();
+    static int16_t read_span(const char* &p);
+    static inline void consume(const uint16_t n) {
+      sdpos += n;
+      if ((ahead_offset += n) >= ahead_len[ahead_r]) {
+        ahead_offset = 0;
+        ahead_r ^= 1;
+        ahead_count--;
+      }
+    }
+  #endif
   static inline int16_t write(void* buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
 
   static Sd2Card& getSd2Card() { return sd2card; }
@@ -245,6 +265,19 @@ private:
 
   static uint32_t filesize, sdpos;
 
+  #if ENABLED(RAPIDIA_SD_READ_AHEAD)
+    static char ahead_buffer[2][RAPIDIA_SD_READ_AHEAD_SIZE];
+    static uint16_t ahead_len[2];   // Bytes read into each buffer
+    static uint8_t ahead_r,         // Buffer being consumed
+                   ahead_count;     // Buffers read and not yet consumed
+    static uint16_t ahead_offset;   // Bytes consumed from ahead_buffer[ahead_r]
+
+    static bool fill_read_ahead();
+    static inline void discard_read_ahead() { ahead_count = ahead_offset = 0; }
+    // (for unbuffered reads: put the file position back at sdpos.)
+    static inline void sync_read_ahead() { if (ahead_count) setIndex(sdpos); }
+  #endif
+
   //
   // Procedure calls to other files
   //
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+
+""" Convert a LINUX simulator GPIO trace (--gpio-trace) to CSV or VCD. """
+
+import argparse
+import sys
+
+# GpioEvent::Type (HAL/LINUX/hardware/Gpio.h)
+NOP, FALL, RISE, SET_VALUE, SETM, SETD = range(6)
+TRACE_OVERFLOW = 0xFF
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument('trace', help='trace file written by the simulator')
+parser.add_argument('-f', '--format', choices=['csv', 'vcd'], default='csv', help='output format (default=csv)')
+parser.add_argument('-o', '--output', help='output file (default=stdout)')
+args = parser.parse_args()
+
+def read_varint(data, i):
+	v = shift = 0
+	while True:
+		b = data[i]
+		i += 1
+		v |= (b & 0x7F) << shift
+		shift += 7
+		if b < 0x80:
+			return v, i
+
+def events(data):
+	""" Yields (timestamp_ns, pin, type) from the trace; overflow markers yield type TRACE_OVERFLOW with the drop count as pin. """
+	if data[:4] != b'GPTR' or data[4] != 1:
+		sys.exit('not a version 1 GPIO trace')
+	i, t = 5, 0
+	while i < len(data):
+		try:
+			zz, i = read_varint(data, i)
+			pin, ev = data[i], data[i + 1]
+			i += 2
+			if ev == TRACE_OVERFLOW:
+				dropped, i = read_varint(data, i)
+				yield t, dropped, ev
+				continue
+		except IndexError:
+			break # (truncated final record -- the simulator was stopped mid-write.)
+		t += (zz >> 1) ^ -(zz & 1)
+		yield t, pin, ev
+
+def write_csv(data, out):
+	# same columns as IOLoggerCSV
+	for t, pin, ev in events(data):
+		if ev == TRACE_OVERFLOW:
+			sys.stderr.write('warning: %d events dropped at %d ns\n' % (pin, t))
+			continue
+		out.write('%d, %d, %d\n' % (t, pin, ev))
+
+def write_vcd(data, out):
+	trace = list(events(data))
+	pins = sorted({ pin for t, pin, ev in trace if ev in (FALL, RISE, SET_VALUE) })
+
+	# VCD identifiers are printable ASCII strings.
+	def ident(pin):
+		s = ''
+		pin += 1
+		while pin:
+			s += chr(33 + pin % 94)
+			pin //= 94
+		return s
+
+	out.write('$timescale 1ns $end\n$scope module gpio $end\n')
+	for pin in pins:
+		out.write('$var wire 1 %s pin%d $end\n' % (ident(pin), pin))
+	out.write('$upscope $end\n$enddefinitions $end\n')
+
+	last_t = None
+	for t, pin, ev in trace:
+		if ev == TRACE_OVERFLOW:
+			sys.stderr.write('warning: %d events dropped at %d ns\n' % (pin, t))
+			continue
+		if ev not in (FALL, RISE, SET_VALUE):
+			continue
+		# (events from signal handlers may be slightly out of order; VCD time can't go backwards.)
+		if last_t is None or t > last_t:
+			out.write('#%d\n' % t)
+			last_t = t
+		# SET_VALUE is an analog write, which has no level in a 1-bit wire.
+		out.write('%s%s\n' % ({ FALL: '0', RISE: '1', SET_VALUE: 'x' }[ev], ident(pin)))
+
+with open(args.trace, 'rb') as f:
+	data = f.read()
+
+out = open(args.output, 'w') if args.output else sys.stdout
+if args.format == 'vcd':
+	write_vcd(data, out)
+else:
+	write_csv(data, out)